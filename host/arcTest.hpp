@@ -0,0 +1,81 @@
+#pragma once
+#include "devils/geometry/pose.hpp"
+#include <cmath>
+#include <cstdio>
+
+namespace devils
+{
+    /**
+     * Checks `Pose::integrateArc` against analytic circular paths.
+     * Stepping along arcs is exact for any step length, so every step count should land on the circle.
+     */
+    class ArcTest
+    {
+    public:
+        /**
+         * Runs each check and prints whether it passed.
+         * @return True if every check passed, false otherwise.
+         */
+        static bool run()
+        {
+            bool isPassing = true;
+            for (int stepCount : {4, 31, 100, 1000})
+                isPassing = _testCircle(stepCount) && isPassing;
+            return _testStraight() && isPassing;
+        }
+
+    private:
+        ArcTest() = delete;
+
+        static constexpr double RADIUS = 24;          // in
+        static constexpr double ANGULAR_VELOCITY = 2; // rad/s
+        static constexpr double DURATION = M_PI;      // s
+        static constexpr double TOLERANCE = 1e-9;     // in
+
+        /**
+         * Drives and strafes around a circle in equal steps, then compares the end pose to the circle.
+         * @param stepCount The number of steps to take.
+         * @return True if both end poses are on the circle, false otherwise.
+         */
+        static bool _testCircle(int stepCount)
+        {
+            double deltaT = DURATION / stepCount;
+            double angle = ANGULAR_VELOCITY * DURATION;
+
+            // Driving forward around a circle
+            Pose driving = Pose(0, 0, 0);
+            for (int i = 0; i < stepCount; i++)
+                driving = driving.integrateArc(RADIUS * ANGULAR_VELOCITY * deltaT, 0, ANGULAR_VELOCITY * deltaT);
+            double drivingError = std::hypot(driving.x - RADIUS * std::sin(angle),
+                                             driving.y - RADIUS * (1 - std::cos(angle)));
+
+            // Strafing sideways around a circle
+            Pose strafing = Pose(0, 0, 0);
+            for (int i = 0; i < stepCount; i++)
+                strafing = strafing.integrateArc(0, RADIUS * ANGULAR_VELOCITY * deltaT, ANGULAR_VELOCITY * deltaT);
+            double strafingError = std::hypot(strafing.x - RADIUS * (std::cos(angle) - 1),
+                                              strafing.y - RADIUS * std::sin(angle));
+
+            bool isRotationCorrect = std::abs(driving.rotation - angle) < TOLERANCE &&
+                                     std::abs(strafing.rotation - angle) < TOLERANCE;
+            bool isPassed = drivingError < TOLERANCE && strafingError < TOLERANCE && isRotationCorrect;
+            printf("%s integrateArc: %4d steps, driving error %.2e in, strafing error %.2e in\n",
+                   isPassed ? "PASS" : "FAIL", stepCount, drivingError, strafingError);
+            return isPassed;
+        }
+
+        /**
+         * Drives a straight line, where the arc has no radius.
+         * @return True if the end pose is on the line, false otherwise.
+         */
+        static bool _testStraight()
+        {
+            Pose straight = Pose(1, 2, M_PI / 4).integrateArc(10, 0, 0);
+            double straightError = std::hypot(straight.x - (1 + 10 * std::cos(M_PI / 4)),
+                                              straight.y - (2 + 10 * std::sin(M_PI / 4)));
+            bool isPassed = straightError < TOLERANCE && straight.rotation == M_PI / 4;
+            printf("%s integrateArc: straight line error %.2e in\n", isPassed ? "PASS" : "FAIL", straightError);
+            return isPassed;
+        }
+    };
+}
\ No newline at end of file
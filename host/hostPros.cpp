@@ -0,0 +1,172 @@
+#include "hostPros.hpp"
+#include "pros/rtos.hpp"
+#include "pros/distance.hpp"
+#include "pros/imu.hpp"
+#include "pros/error.h"
+#include "okapi/api/util/logging.hpp"
+#include <cerrno>
+#include <stdexcept>
+
+/*
+ * Host definitions of the PROS and OkapiLib functions that the devils headers link against.
+ * Only what the host tools use is defined. Anything that needs real hardware or tasks reports an error.
+ */
+
+namespace
+{
+    constexpr int PORT_COUNT = 22;
+    constexpr int32_t NO_OBJECT_DISTANCE = 9999; // mm
+
+    uint32_t currentTime = 0; // ms
+    int32_t distances[PORT_COUNT] = {0};
+    bool hasDistances = false;
+}
+
+namespace devils
+{
+    void HostPros::setTime(uint32_t timestamp)
+    {
+        currentTime = timestamp;
+    }
+
+    void HostPros::setDistance(uint8_t port, int32_t distance)
+    {
+        if (!hasDistances)
+        {
+            for (int32_t &value : distances)
+                value = NO_OBJECT_DISTANCE;
+            hasDistances = true;
+        }
+        if (port < PORT_COUNT)
+            distances[port] = distance;
+    }
+}
+
+// RTOS
+uint32_t pros::c::millis(void)
+{
+    return currentTime;
+}
+
+uint64_t pros::c::micros(void)
+{
+    return currentTime * (uint64_t)1000;
+}
+
+char *pros::c::task_get_name(pros::task_t task)
+{
+    static char name[] = "host";
+    return name;
+}
+
+namespace pros
+{
+    Task::Task(task_fn_t function, void *parameters, std::uint32_t prio, std::uint16_t stack_depth, const char *name)
+    {
+        throw std::logic_error("Tasks are not available on the host");
+    }
+
+    void Task::delay_until(std::uint32_t *const prev_time, const std::uint32_t delta)
+    {
+        *prev_time += delta;
+        if (currentTime < *prev_time)
+            currentTime = *prev_time;
+    }
+
+    // The host tools are single threaded
+    Mutex::Mutex() {}
+
+    bool Mutex::take()
+    {
+        return true;
+    }
+
+    bool Mutex::take(std::uint32_t timeout)
+    {
+        return true;
+    }
+
+    bool Mutex::give()
+    {
+        return true;
+    }
+
+    // Distance Sensor
+    Distance::Distance(const std::uint8_t port) : _port(port) {}
+
+    std::int32_t Distance::get()
+    {
+        if (!hasDistances || _port >= PORT_COUNT)
+            return NO_OBJECT_DISTANCE;
+        return distances[_port];
+    }
+
+    std::int32_t Distance::get_confidence()
+    {
+        return 63;
+    }
+
+    std::int32_t Distance::get_object_size()
+    {
+        return 0;
+    }
+
+    double Distance::get_object_velocity()
+    {
+        return 0;
+    }
+
+    std::uint8_t Distance::get_port()
+    {
+        return _port;
+    }
+
+    // IMU
+    // Never connected on the host
+    double Imu::get_heading() const
+    {
+        errno = ENODEV;
+        return PROS_ERR_F;
+    }
+
+    pros::c::imu_gyro_s_t Imu::get_gyro_rate() const
+    {
+        errno = ENODEV;
+        return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    }
+
+    std::int32_t Imu::set_heading(const double target) const
+    {
+        errno = ENODEV;
+        return PROS_ERR;
+    }
+}
+
+// Logging
+// Log statements are dropped, since the host tools print their own results
+namespace okapi
+{
+    int DefaultLoggerInitializer::count = 0;
+    std::shared_ptr<Logger> defaultLogger;
+
+    Logger::Logger() noexcept
+        : timer(nullptr),
+          logLevel(LogLevel::off),
+          logfile(nullptr)
+    {
+    }
+
+    Logger::~Logger()
+    {
+    }
+
+    std::shared_ptr<Logger> Logger::getDefaultLogger()
+    {
+        return defaultLogger;
+    }
+
+    void Logger::setDefaultLogger(std::shared_ptr<Logger> ilogger)
+    {
+        defaultLogger = ilogger;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+
+namespace devils
+{
+    /**
+     * Controls the host stand-ins for the PROS functions used by the devils headers.
+     * Time only moves when it is set, so replaying a log runs as fast as the computer allows
+     * and gives the same result every time.
+     */
+    struct HostPros
+    {
+        /**
+         * Sets the time returned by `pros::millis()` and `pros::micros()`.
+         * @param timestamp The time in milliseconds.
+         */
+        static void setTime(uint32_t timestamp);
+
+        /**
+         * Sets the reading of the distance sensor on a port.
+         * @param port The port of the distance sensor (from 1 to 21).
+         * @param distance The distance in millimeters, or 9999 if nothing is in range.
+         */
+        static void setDistance(uint8_t port, int32_t distance);
+
+    private:
+        HostPros() = delete;
+    };
+}
\ No newline at end of file
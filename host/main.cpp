@@ -0,0 +1,196 @@
+#include "hostPros.hpp"
+#include "arcTest.hpp"
+#include "odomLogReader.hpp"
+#include "odomComparison.hpp"
+#include "devils/odom/particleFilter.hpp"
+#include "devils/path/occupancyFileReader.hpp"
+#include "devils/geometry/pose.hpp"
+#include "devils/geometry/units.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Runs the devils headers on a desktop computer, to test and tune localization without a robot.
+ *
+ *   devils-host test                                Checks Pose::integrateArc against circular paths.
+ *   devils-host simulate <log file> <occupancy>     Writes a simulated log of a robot driving laps.
+ *   devils-host replay <log file> <occupancy>       Replays a log through each fused odometry source,
+ *                                                   and prints their cost and error.
+ *
+ * Logs are recorded on the robot with `OdomRecorder`. Errors can only be measured on logs with `TRUTH` lines.
+ */
+
+using namespace devils;
+
+/**
+ * A motion of the simulated robot at a constant speed and turn rate.
+ */
+struct SimulatedSegment
+{
+    uint32_t duration;      // ms
+    double velocity;        // in/s
+    double angularVelocity; // rad/s
+};
+
+static constexpr uint32_t SIMULATION_SEED = 1;
+static constexpr uint32_t SIMULATION_START = 1000;             // ms
+static constexpr uint32_t SIMULATION_PERIOD = 10;              // ms
+static constexpr uint32_t SIMULATED_GPS_PERIOD = 50;           // ms
+static constexpr uint32_t SIMULATED_GPS_LATENCY = 30;          // ms
+static constexpr double SIMULATED_GPS_STD_DEV = 1.0;           // in
+static constexpr double SIMULATED_GPS_ROTATION_STD_DEV = 0.02; // rad
+static constexpr double SIMULATED_GPS_OUTLIER_CHANCE = 0.02;   // %
+static constexpr double SIMULATED_GPS_OUTLIER_DISTANCE = 18.0; // in
+static constexpr double SIMULATED_WHEEL_SCALE = 1.02;          // %
+static constexpr double SIMULATED_WHEEL_ROTATION_SCALE = 1.01; // %
+static constexpr double SIMULATED_WHEEL_STD_DEV = 0.01;        // in
+static constexpr double SIMULATED_DISTANCE_STD_DEV = 0.5;      // in
+static constexpr double SIMULATED_MAX_DISTANCE = 100.0;        // in
+
+/**
+ * Simulates a robot driving laps around an open area of the field and writes what its sensors would have recorded.
+ * The wheels drift, the GPS is noisy, late and sometimes wrong, and the distance sensors see the occupancy grid.
+ * @param logPath The path to write the log to.
+ * @param occupancyGrid The occupancy grid of the field.
+ * @return True if the log was written, false otherwise.
+ */
+static bool simulate(std::string logPath, OccupancyGrid &occupancyGrid)
+{
+    std::ofstream file(logPath);
+    if (!file.is_open())
+    {
+        fprintf(stderr, "Failed to open %s\n", logPath.c_str());
+        return false;
+    }
+
+    std::mt19937 random(SIMULATION_SEED);
+    std::normal_distribution<double> normal(0, 1);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    ParticleFilter field(1);
+    field.useOccupancyGrid(occupancyGrid);
+
+    // Two laps of a 42in by 16in oval
+    std::vector<SimulatedSegment> segments = {{500, 0, 0}};
+    for (int lap = 0; lap < 2; lap++)
+    {
+        segments.push_back({1750, 24, 0});
+        segments.push_back({1047, 24, 3});
+        segments.push_back({1750, 24, 0});
+        segments.push_back({1047, 24, 3});
+    }
+    std::vector<Pose> sensorOffsets = {Pose(6, 0, 0), Pose(0, 6, M_PI / 2), Pose(0, -6, -M_PI / 2)};
+
+    file << std::fixed << std::setprecision(4);
+    file << "ODOMLOG 1\n";
+    for (int i = 0; i < sensorOffsets.size(); i++)
+        file << "SENSOR " << i << " " << sensorOffsets[i].x << " " << sensorOffsets[i].y << " " << sensorOffsets[i].rotation << "\n";
+
+    Pose truth = Pose(-14, -21, M_PI / 2);
+    Pose wheel = truth;
+    std::vector<Pose> truthHistory;
+    uint32_t timestamp = SIMULATION_START;
+    double deltaT = SIMULATION_PERIOD / 1000.0;
+    for (SimulatedSegment &segment : segments)
+    {
+        for (uint32_t elapsed = 0; elapsed < segment.duration; elapsed += SIMULATION_PERIOD)
+        {
+            timestamp += SIMULATION_PERIOD;
+
+            // Move
+            double distance = segment.velocity * deltaT;
+            double rotation = segment.angularVelocity * deltaT;
+            truth = truth.integrateArc(distance, 0, rotation);
+            truthHistory.push_back(truth);
+            double wheelNoise = distance != 0 ? normal(random) * SIMULATED_WHEEL_STD_DEV : 0;
+            wheel = wheel.integrateArc(distance * SIMULATED_WHEEL_SCALE + wheelNoise, 0, rotation * SIMULATED_WHEEL_ROTATION_SCALE);
+            file << "WHEEL " << timestamp << " " << wheel.x << " " << wheel.y << " " << Units::normalizeRadians(wheel.rotation) << "\n";
+
+            // GPS
+            int latencyTicks = SIMULATED_GPS_LATENCY / SIMULATION_PERIOD;
+            if (timestamp % SIMULATED_GPS_PERIOD == 0 && truthHistory.size() > latencyTicks)
+            {
+                Pose measured = truthHistory[truthHistory.size() - 1 - latencyTicks];
+                measured.x += normal(random) * SIMULATED_GPS_STD_DEV;
+                measured.y += normal(random) * SIMULATED_GPS_STD_DEV;
+                measured.rotation += normal(random) * SIMULATED_GPS_ROTATION_STD_DEV;
+                if (uniform(random) < SIMULATED_GPS_OUTLIER_CHANCE)
+                    measured.x += SIMULATED_GPS_OUTLIER_DISTANCE;
+                file << "GPS " << timestamp - SIMULATED_GPS_LATENCY << " " << measured.x << " " << measured.y << " "
+                     << Units::normalizeRadians(measured.rotation) << " " << SIMULATED_GPS_STD_DEV << "\n";
+            }
+
+            // Distance Sensors
+            for (int i = 0; i < sensorOffsets.size(); i++)
+            {
+                Pose &offset = sensorOffsets[i];
+                double sensorX = truth.x + offset.x * std::cos(truth.rotation) - offset.y * std::sin(truth.rotation);
+                double sensorY = truth.y + offset.x * std::sin(truth.rotation) + offset.y * std::cos(truth.rotation);
+                double distance = field._raycast(sensorX, sensorY, truth.rotation + offset.rotation, SIMULATED_MAX_DISTANCE);
+                if (distance < SIMULATED_MAX_DISTANCE)
+                    file << "DISTANCE " << i << " " << std::max(distance + normal(random) * SIMULATED_DISTANCE_STD_DEV, 0.0) << "\n";
+            }
+
+            file << "TRUTH " << truth.x << " " << truth.y << " " << Units::normalizeRadians(truth.rotation) << "\n";
+        }
+    }
+
+    file << "ENDODOMLOG\n";
+    printf("Wrote %d updates to %s\n", (int)truthHistory.size(), logPath.c_str());
+    return true;
+}
+
+/**
+ * Reads an occupancy grid from a file.
+ * @param path The path to the occupancy file.
+ * @return The occupancy grid, or an empty grid if the file could not be read.
+ */
+static OccupancyGrid readOccupancyGrid(std::string path)
+{
+    std::ifstream file(path);
+    std::stringstream data;
+    data << file.rdbuf();
+    return OccupancyFileReader::deserialize(data.str());
+}
+
+int main(int argc, char **argv)
+{
+    std::string command = argc > 1 ? argv[1] : "";
+
+    if (command == "test")
+        return ArcTest::run() ? 0 : 1;
+
+    if ((command == "simulate" || command == "replay") && argc > 3)
+    {
+        OccupancyGrid occupancyGrid = readOccupancyGrid(argv[3]);
+        if (occupancyGrid.width <= 0 || occupancyGrid.height <= 0)
+        {
+            fprintf(stderr, "Failed to read an occupancy grid from %s\n", argv[3]);
+            return 1;
+        }
+
+        if (command == "simulate")
+            return simulate(argv[2], occupancyGrid) ? 0 : 1;
+
+        OdomLog log = OdomLogReader::readFromFile(argv[2]);
+        if (log.ticks.empty())
+        {
+            fprintf(stderr, "Failed to read an odometry log from %s\n", argv[2]);
+            return 1;
+        }
+        OdomComparison::run(log, occupancyGrid);
+        return 0;
+    }
+
+    fprintf(stderr,
+            "Usage:\n"
+            "  devils-host test\n"
+            "  devils-host simulate <log file> <occupancy file>\n"
+            "  devils-host replay <log file> <occupancy file>\n");
+    return 1;
+}
\ No newline at end of file
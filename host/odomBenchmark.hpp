@@ -0,0 +1,144 @@
+#pragma once
+#include "hostPros.hpp"
+#include "odomLogReader.hpp"
+#include "replayOdom.hpp"
+#include "devils/geometry/pose.hpp"
+#include "devils/geometry/units.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace devils
+{
+    /**
+     * Replays a log through an odometry source, timing each update and comparing each pose to the truth.
+     * Sources are built on `ReplayOdom`s, so they see the wheels and GPS exactly as they were recorded.
+     */
+    class OdomBenchmark
+    {
+    public:
+        /**
+         * The cost and accuracy of an odometry source over a replay.
+         */
+        struct Result
+        {
+            std::string name;
+            int updateCount = 0;
+            double totalMicros = 0;     // us
+            double maxMicros = 0;       // us
+            int errorCount = 0;
+            double squaredError = 0;    // in^2
+            double maxError = 0;        // in
+            double squaredRotation = 0; // rad^2
+        };
+
+        /**
+         * Replays a log through an odometry source.
+         * @param name The name to print the source as.
+         * @param log The log to replay.
+         * @param createSource Creates the source from the replayed wheel odometry and GPS.
+         * @return The cost and accuracy of the source.
+         */
+        template <typename Source, typename CreateSource>
+        static Result replay(std::string name, OdomLog &log, CreateSource createSource)
+        {
+            Result result;
+            result.name = name;
+            if (log.ticks.empty())
+                return result;
+
+            // Start where the wheels started, like an autonomous routine would
+            ReplayOdom wheelOdom;
+            ReplayOdom gps;
+            HostPros::setTime(log.ticks.front().wheel.timestamp);
+            std::unique_ptr<Source> source = createSource(wheelOdom, gps);
+            Pose startPose = log.ticks.front().wheel.getPose();
+            source->setPose(startPose);
+
+            for (OdomLogTick &tick : log.ticks)
+            {
+                // Play the readings
+                HostPros::setTime(tick.wheel.timestamp);
+                wheelOdom.play(tick.wheel);
+                if (tick.hasGPS)
+                    gps.play(tick.gps);
+                for (int i = 0; i < tick.distances.size(); i++)
+                {
+                    double distance = tick.distances[i];
+                    HostPros::setDistance(i + 1, distance < 0 ? NO_OBJECT_DISTANCE : (int32_t)std::round(Units::inToMeters(distance) * 1000));
+                }
+
+                // Update
+                auto startTime = std::chrono::steady_clock::now();
+                source->update();
+                double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+                result.updateCount++;
+                result.totalMicros += micros;
+                result.maxMicros = std::max(result.maxMicros, micros);
+
+                if (tick.hasTruth)
+                    addError(result, source->getSnapshot().getPose(), tick.truth);
+            }
+            return result;
+        }
+
+        /**
+         * Adds the error of a pose to a result.
+         * @param result The result to add to.
+         * @param pose The estimated pose.
+         * @param truth Where the robot really was.
+         */
+        static void addError(Result &result, Pose pose, Pose &truth)
+        {
+            double error = std::hypot(pose.x - truth.x, pose.y - truth.y);
+            double rotationError = Units::diffRad(pose.rotation, truth.rotation);
+            result.errorCount++;
+            result.squaredError += error * error;
+            result.squaredRotation += rotationError * rotationError;
+            result.maxError = std::max(result.maxError, error);
+        }
+
+        /**
+         * Prints the header of the result table.
+         */
+        static void printHeader()
+        {
+            printf("%-28s %9s %9s %10s %10s %10s\n", "Source", "Mean us", "Max us", "RMS in", "Max in", "RMS deg");
+        }
+
+        /**
+         * Prints a row of the result table. Values that were not measured are printed as `-`.
+         * @param result The result to print.
+         */
+        static void printResult(Result &result)
+        {
+            char meanMicros[16] = "-";
+            char maxMicros[16] = "-";
+            if (result.updateCount > 0)
+            {
+                snprintf(meanMicros, sizeof(meanMicros), "%.1f", result.totalMicros / result.updateCount);
+                snprintf(maxMicros, sizeof(maxMicros), "%.1f", result.maxMicros);
+            }
+
+            char rmsError[16] = "-";
+            char maxError[16] = "-";
+            char rmsRotation[16] = "-";
+            if (result.errorCount > 0)
+            {
+                snprintf(rmsError, sizeof(rmsError), "%.2f", std::sqrt(result.squaredError / result.errorCount));
+                snprintf(maxError, sizeof(maxError), "%.2f", result.maxError);
+                snprintf(rmsRotation, sizeof(rmsRotation), "%.2f", Units::radToDeg(std::sqrt(result.squaredRotation / result.errorCount)));
+            }
+
+            printf("%-28s %9s %9s %10s %10s %10s\n", result.name.c_str(), meanMicros, maxMicros, rmsError, maxError, rmsRotation);
+        }
+
+    private:
+        OdomBenchmark() = delete;
+
+        static constexpr int32_t NO_OBJECT_DISTANCE = 9999; // mm
+    };
+}
\ No newline at end of file
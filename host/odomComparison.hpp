@@ -0,0 +1,79 @@
+#pragma once
+#include "odomBenchmark.hpp"
+#include "odomLogReader.hpp"
+#include "replayOdom.hpp"
+#include "devils/odom/complementaryFilterOdom.hpp"
+#include "devils/odom/extendedKalmanFilterOdom.hpp"
+#include "devils/odom/unscentedKalmanFilterOdom.hpp"
+#include "devils/odom/monteCarloOdom.hpp"
+#include "devils/hardware/distanceSensor.hpp"
+#include "devils/path/occupancyGrid.hpp"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Compares the cost and accuracy of each fused odometry source on the same log,
+     * with the wheels alone as a baseline.
+     */
+    class OdomComparison
+    {
+    public:
+        /**
+         * Replays a log through each fused odometry source and prints their cost and error.
+         * @param log The log to replay.
+         * @param occupancyGrid The occupancy grid of the field, for the particle filter.
+         */
+        static void run(OdomLog &log, OccupancyGrid &occupancyGrid)
+        {
+            // Distance sensors are played on ports 1 and up
+            std::vector<std::unique_ptr<DistanceSensor>> distanceSensors;
+            for (int i = 0; i < log.sensorOffsets.size(); i++)
+                distanceSensors.push_back(std::make_unique<DistanceSensor>("Distance " + std::to_string(i), i + 1));
+
+            std::vector<OdomBenchmark::Result> results;
+
+            // Wheels alone, as a baseline
+            OdomBenchmark::Result wheelResult;
+            wheelResult.name = "Wheel odometry";
+            for (OdomLogTick &tick : log.ticks)
+                if (tick.hasTruth)
+                    OdomBenchmark::addError(wheelResult, tick.wheel.getPose(), tick.truth);
+            results.push_back(wheelResult);
+
+            results.push_back(OdomBenchmark::replay<ComplementaryFilterOdom>(
+                "ComplementaryFilterOdom", log,
+                [](ReplayOdom &wheelOdom, ReplayOdom &gps)
+                { return std::make_unique<ComplementaryFilterOdom>(&gps, &wheelOdom, 0.003); }));
+            results.push_back(OdomBenchmark::replay<ExtendedKalmanFilterOdom>(
+                "ExtendedKalmanFilterOdom", log,
+                [](ReplayOdom &wheelOdom, ReplayOdom &gps)
+                { return std::make_unique<ExtendedKalmanFilterOdom>(&wheelOdom, nullptr, &gps); }));
+            results.push_back(OdomBenchmark::replay<UnscentedKalmanFilterOdom>(
+                "UnscentedKalmanFilterOdom", log,
+                [](ReplayOdom &wheelOdom, ReplayOdom &gps)
+                { return std::make_unique<UnscentedKalmanFilterOdom>(&wheelOdom, nullptr, &gps); }));
+            results.push_back(OdomBenchmark::replay<MonteCarloOdom>(
+                "MonteCarloOdom", log,
+                [&](ReplayOdom &wheelOdom, ReplayOdom &gps)
+                {
+                    auto odom = std::make_unique<MonteCarloOdom>(&wheelOdom, occupancyGrid, &gps);
+                    for (int i = 0; i < distanceSensors.size(); i++)
+                        odom->addDistanceSensor(*distanceSensors[i], log.sensorOffsets[i]);
+                    return odom;
+                }));
+
+            printf("Replayed %d updates with %d distance sensors\n", (int)log.ticks.size(), (int)log.sensorOffsets.size());
+            OdomBenchmark::printHeader();
+            for (OdomBenchmark::Result &result : results)
+                OdomBenchmark::printResult(result);
+            printf("Times are on this computer, not the V5 brain. Compare them to each other.\n");
+        }
+
+    private:
+        OdomComparison() = delete;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+#include "devils/odom/poseHistory.hpp"
+#include "devils/geometry/pose.hpp"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * A single odometry update from a log: the wheel snapshot and any readings that came with it.
+     */
+    struct OdomLogTick
+    {
+        /// @brief The wheel odometry snapshot, which also times the update.
+        PoseSample wheel;
+
+        /// @brief True if the GPS had a new snapshot on this update.
+        bool hasGPS = false;
+
+        /// @brief The GPS snapshot, timestamped when it was measured.
+        PoseSample gps;
+
+        /// @brief The distance to each sensor's target in inches, or a negative value if it saw nothing.
+        std::vector<double> distances;
+
+        /// @brief True if the log knows where the robot really was, such as a simulated log.
+        bool hasTruth = false;
+
+        /// @brief Where the robot really was.
+        Pose truth;
+    };
+
+    /**
+     * A log recorded by `OdomRecorder` or written by `devils-host simulate`.
+     */
+    struct OdomLog
+    {
+        /// @brief The pose of each distance sensor relative to the center of the robot.
+        std::vector<Pose> sensorOffsets;
+
+        /// @brief Every update in the order it was recorded.
+        std::vector<OdomLogTick> ticks;
+    };
+
+    /**
+     * Reads an odometry log. See `OdomRecorder` for the format.
+     * Logs written by the simulator also have a `TRUTH x y rotation` line after each `WHEEL` line.
+     */
+    class OdomLogReader
+    {
+    public:
+        /**
+         * Reads an odometry log from a file.
+         * @param path The path to the log file.
+         * @return The deserialized log. Empty if the file could not be read.
+         */
+        static OdomLog readFromFile(std::string path)
+        {
+            std::ifstream file(path);
+            std::stringstream data;
+            data << file.rdbuf();
+            return deserialize(data.str());
+        }
+
+        /**
+         * Deserializes an odometry log from a string.
+         * Lines before a `WHEEL` line and unknown lines are ignored.
+         * @param data The data to deserialize.
+         * @return The deserialized log.
+         */
+        static OdomLog deserialize(std::string data)
+        {
+            OdomLog log;
+
+            std::string line;
+            std::istringstream readStream(data);
+            while (std::getline(readStream, line))
+            {
+                std::istringstream lineStream(line);
+                std::string type;
+                lineStream >> type;
+
+                if (type == "ENDODOMLOG")
+                    break;
+
+                if (type == "SENSOR")
+                {
+                    int index;
+                    Pose offset;
+                    if (!(lineStream >> index >> offset.x >> offset.y >> offset.rotation) || index < 0)
+                        continue;
+                    if (index >= log.sensorOffsets.size())
+                        log.sensorOffsets.resize(index + 1);
+                    log.sensorOffsets[index] = offset;
+                }
+                else if (type == "WHEEL")
+                {
+                    OdomLogTick tick;
+                    if (!(lineStream >> tick.wheel.timestamp >> tick.wheel.x >> tick.wheel.y >> tick.wheel.rotation))
+                        continue;
+                    tick.distances.assign(log.sensorOffsets.size(), -1);
+                    log.ticks.push_back(tick);
+                }
+                else if (log.ticks.empty())
+                {
+                    continue;
+                }
+                else if (type == "GPS")
+                {
+                    OdomLogTick &tick = log.ticks.back();
+                    PoseSample &gps = tick.gps;
+                    tick.hasGPS = (bool)(lineStream >> gps.timestamp >> gps.x >> gps.y >> gps.rotation >> gps.positionError);
+                }
+                else if (type == "DISTANCE")
+                {
+                    OdomLogTick &tick = log.ticks.back();
+                    int index;
+                    double distance;
+                    if (!(lineStream >> index >> distance) || index < 0 || index >= tick.distances.size())
+                        continue;
+                    tick.distances[index] = distance;
+                }
+                else if (type == "TRUTH")
+                {
+                    OdomLogTick &tick = log.ticks.back();
+                    tick.hasTruth = (bool)(lineStream >> tick.truth.x >> tick.truth.y >> tick.truth.rotation);
+                }
+            }
+
+            return log;
+        }
+
+    private:
+        OdomLogReader() = delete;
+    };
+}
\ No newline at end of file
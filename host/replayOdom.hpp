@@ -0,0 +1,69 @@
+#pragma once
+#include "devils/odom/odomSource.hpp"
+#include "devils/odom/poseHistory.hpp"
+#include "devils/geometry/pose.hpp"
+
+namespace devils
+{
+    /**
+     * Represents an odometry source that plays back snapshots from a log.
+     * Keeps a pose history like the real sources, so latency compensation behaves the same in a replay.
+     */
+    class ReplayOdom : public OdomSource
+    {
+    public:
+        /**
+         * Publishes the next snapshot from the log.
+         * @param sample The recorded snapshot.
+         */
+        void play(PoseSample sample)
+        {
+            snapshot = sample;
+            currentPose = sample.getPose();
+            history.record(sample);
+        }
+
+        /**
+         * Gets the last played pose.
+         * @return The last played pose.
+         */
+        Pose &getPose() override
+        {
+            return currentPose;
+        }
+
+        /**
+         * Does nothing, since the log already has every pose the source reported.
+         * @param pose The pose to set the robot to.
+         */
+        void setPose(Pose &pose) override
+        {
+        }
+
+        /**
+         * Gets the last played snapshot.
+         * @return The last played snapshot.
+         */
+        PoseSample getSnapshot() override
+        {
+            return snapshot;
+        }
+
+        /**
+         * Gets the pose of the robot at a past time, interpolated from the played snapshots.
+         * @param timestamp The time to look up in milliseconds.
+         * @return The pose of the robot at the timestamp.
+         */
+        Pose getPoseAt(uint32_t timestamp) override
+        {
+            if (history.getSize() == 0)
+                return currentPose;
+            return history.getPoseAt(timestamp);
+        }
+
+    private:
+        Pose currentPose = Pose();
+        PoseSample snapshot;
+        PoseHistory history;
+    };
+}
\ No newline at end of file
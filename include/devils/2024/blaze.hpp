@@ -21,9 +21,8 @@ namespace devils
             bounceController.setSpeeds(1.0, -1.1);
             bounceController.setDurations(700, 700);
 
-            // Run Odom
+            // Setup Odom
             wheelOdom.useIMU(imu);
-            wheelOdom.runAsync();
 
             // Display
             statsRenderer->useOdomSource(&wheelOdom);
@@ -31,7 +30,11 @@ namespace devils
             autoController.usePathRenderer(*pathRenderer);
             statsRenderer->useAutoPickerRenderer(autoPickerRenderer);
 
-            mainDisplay.runAsync();
+            // Run Tasks
+            scheduler.add(wheelOdom, "Blaze.Odom", ODOM_PERIOD);
+            scheduler.add(slipDetector, "Blaze.SlipDetector", ODOM_PERIOD);
+            scheduler.add(mainDisplay, "Blaze.Display", DISPLAY_PERIOD);
+            scheduler.start();
         }
 
         void autonomous() override
@@ -45,8 +48,14 @@ namespace devils
             // Reset Odom
             wheelOdom.setPose(*autoController.getStartingPose());
 
+            // Off-Path Recovery
+            if (SDCard::isInserted())
+                autoController.useOccupancyGrid(OccupancyFileReader::readFromSD());
+
             // Set Speed
+            // Scale both sides together when saturated, so the controllers get the curvature they asked for
             chassis.setSpeed(CHASSIS_AUTO_FORWARD, CHASSIS_AUTO_TURN);
+            chassis.setDesaturationMode(TankChassis::PROPORTIONAL);
 
             // Calibrate IMU
             imu.calibrate();
@@ -55,11 +64,75 @@ namespace devils
             // Reset Auto Controller
             autoController.reset();
 
+            // Ignore bumps from before autonomous
+            slipDetector.consumeImpact();
+
             EventTimer pauseTimer = EventTimer();
             EventTimer bounceTimer = EventTimer();
 
+            // Event Handlers
+            EventDispatcher dispatcher;
+
+            // Intake
+            dispatcher.on("intake", [&](PathEvent &event)
+                          { outerIntake.intake(); innerIntake.intake(); });
+            dispatcher.on("outtake", [&](PathEvent &event)
+                          { outerIntake.outtake(); innerIntake.outtake(); });
+            dispatcher.on("stopIntake", [&](PathEvent &event)
+                          { outerIntake.stop(); innerIntake.stop(); });
+
+            // Raise/Lower Intake
+            dispatcher.on("raiseIntake", [&](PathEvent &event)
+                          { outerIntake.retract(); });
+            dispatcher.on("lowerIntake", [&](PathEvent &event)
+                          { outerIntake.extend(); });
+
+            // Launcher
+            dispatcher.on("fire", [&](PathEvent &event)
+                          { launcher.firePID(); });
+            dispatcher.on("stopLauncher", [&](PathEvent &event)
+                          { launcher.stop(); });
+
+            // Other
+            dispatcher.on("pause", [&](PathEvent &event)
+                          { pauseTimer.start(event.id, event.value); });
+            dispatcher.on("setSpeed", [&](PathEvent &event)
+                          { chassis.setSpeed(event.value * CHASSIS_AUTO_FORWARD, CHASSIS_AUTO_TURN); });
+            dispatcher.on("bounce", [&](PathEvent &event)
+                          { bounceTimer.start(event.id, event.value); });
+            dispatcher.on("alignToAngle", [&](PathEvent &event)
+                          {
+                              double angleRad = Units::degToRad(event.value);
+                              double deltaAngle = Units::diffRad(angleRad, imu.getHeading());
+
+                              bounceController.setRotation(deltaAngle);
+                              if (pauseTimer.getRunning())
+                                  chassis.move(0.0, deltaAngle * 2.0); });
+
+            // Script
+            uint32_t autoStartTime = pros::millis();
+            ScriptVM script(dispatcher);
+            script.bindSensor("launcherAtSpeed", [&]()
+                              { return launcher.isAtSpeed(); });
+            script.bindSensor("autoFinished", [&]()
+                              { return autoController.getFinished(); });
+            script.bindSensor("slipping", [&]()
+                              { return slipDetector.isSlipping(); });
+            script.bindSensor("time", [&]()
+                              { return pros::millis() - autoStartTime; });
+            if (SDCard::isInserted())
+                script.load(ScriptCompiler::readFromSD());
+
+            // Script time counts from here, after calibration and loading
+            autoStartTime = pros::millis();
+
+            LoopRate rate("Blaze.Autonomous", AUTO_LOOP_PERIOD);
             while (true)
             {
+                // Replan After Impact
+                if (slipDetector.consumeImpact())
+                    autoController.replan();
+
                 // Run Auto Controller
                 if (pauseTimer.getRunning())
                     chassis.stop();
@@ -71,82 +144,14 @@ namespace devils
                     bounceController.update();
 
                 // Handle Auto Controller Events
-                PathEvents *events = autoController.getState().events;
-                for (PathEvent event : *events)
-                {
-                    // Post-Pause Events
-                    bool isPaused = pauseTimer.getRunning() || bounceTimer.getRunning();
-                    if (event.params == "afterPause" && isPaused)
-                        continue;
-
-                    // Intake
-                    else if (event.name == "intake")
-                    {
-                        outerIntake.intake();
-                        innerIntake.intake();
-                    }
-                    else if (event.name == "outtake")
-                    {
-                        outerIntake.outtake();
-                        innerIntake.outtake();
-                    }
-                    else if (event.name == "stopIntake")
-                    {
-                        outerIntake.stop();
-                        innerIntake.stop();
-                    }
-
-                    // Raise/Lower Intake
-                    else if (event.name == "raiseIntake")
-                    {
-                        outerIntake.retract();
-                    }
-                    else if (event.name == "lowerIntake")
-                    {
-                        outerIntake.extend();
-                    }
-
-                    // Launcher
-                    else if (event.name == "fire")
-                    {
-                        launcher.firePID();
-                    }
-                    else if (event.name == "stopLauncher")
-                    {
-                        launcher.stop();
-                    }
-
-                    // Other
-                    else if (event.name == "pause")
-                    {
-                        pauseTimer.start(event.id, std::stoi(event.params));
-                    }
-                    else if (event.name == "setSpeed")
-                    {
-                        chassis.setSpeed(std::stod(event.params) * CHASSIS_AUTO_FORWARD, CHASSIS_AUTO_TURN);
-                    }
-                    else if (event.name == "bounce")
-                    {
-                        bounceTimer.start(event.id, std::stoi(event.params));
-                    }
-                    else if (event.name == "alignToAngle")
-                    {
-                        double angleDeg = std::stod(event.params);
-                        double angleRad = Units::degToRad(angleDeg);
-                        double deltaAngle = Units::diffRad(angleRad, imu.getHeading());
-
-                        bounceController.setRotation(deltaAngle);
-                        if (pauseTimer.getRunning())
-                            chassis.move(0.0, deltaAngle * 2.0);
-                    }
-                    else
-                    {
-                        Logger::warn("Unknown Event: " + event.name);
-                    }
-                }
+                bool isPaused = pauseTimer.getRunning() || bounceTimer.getRunning();
+                dispatcher.dispatch(*autoController.getState().events, isPaused);
+
+                // Run Script
+                script.update();
 
                 // Pause
-                pros::delay(20);
+                rate.wait();
             }
         }
 
@@ -154,6 +159,7 @@ namespace devils
         {
             // Reset Speed
             chassis.setSpeed(1.0, 1.0);
+            chassis.setDesaturationMode(TankChassis::CLAMP);
 
             // Control
             bool runFlywheel = false;
@@ -162,6 +168,7 @@ namespace devils
             double flywheelVoltage = 0.5;
 
             // Loop
+            LoopRate rate("Blaze.OpControl", OPCONTROL_LOOP_PERIOD);
             while (true)
             {
                 // Take Controller Inputs
@@ -177,6 +184,8 @@ namespace devils
                 bool upButon = mainController.get_digital_new_press(DIGITAL_UP);
                 bool downButton = mainController.get_digital_new_press(DIGITAL_DOWN);
                 bool extendButton = mainController.get_digital_new_press(DIGITAL_LEFT);
+                bool tuneLauncherButton = mainController.get_digital_new_press(DIGITAL_B);
+                bool tuneChassisButton = mainController.get_digital_new_press(DIGITAL_Y);
 
                 // Curve Joystick Inputs
                 leftX = JoystickCurve::curve(leftX, 2.0, 0.1);
@@ -256,11 +265,33 @@ namespace devils
                 else
                     launcherHood.retract();
 
-                // Delay to prevent the CPU from being overloaded
-                pros::delay(10); // <-- Smaller delay to improve PID loop
+                // Auto-Tune (Practice Only)
+                bool canTune = !pros::competition::is_connected();
+                if (tuneLauncherButton && canTune)
+                    launcher.tune(flywheelVoltage);
+                if (tuneChassisButton && canTune)
+                    tuneChassis();
+
+                // Wait for the next period
+                rate.wait();
             }
         }
 
+        /**
+         * Auto-tunes the chassis PID gains and saves them to the SD card.
+         * The robot will rock back and forth in place for several seconds.
+         */
+        void tuneChassis()
+        {
+            auto rotationGains = RelayTuner::tuneRotation(chassis, wheelOdom, CHASSIS_TUNE_AMPLITUDE);
+            if (rotationGains.has_value())
+                TuningFile::savePID("Chassis.Rotation", *rotationGains);
+
+            auto translationGains = RelayTuner::tuneTranslation(chassis, wheelOdom, CHASSIS_TUNE_AMPLITUDE);
+            if (translationGains.has_value())
+                TuningFile::savePID("Chassis.Translation", *translationGains);
+        }
+
         void disabled() override
         {
             // Stop the robot
@@ -268,6 +299,10 @@ namespace devils
             launcher.stop();
             outerIntake.stop();
             innerIntake.stop();
+
+            // Save Profile
+            Profiler::log();
+            Profiler::saveToSD();
         }
 
     private:
@@ -283,9 +318,16 @@ namespace devils
         static constexpr uint8_t IMU_SENSOR_PORT = 14;
 
         // Speeds
-        static constexpr double CHASSIS_AUTO_FORWARD = 0.3; // % speed
-        static constexpr double CHASSIS_AUTO_TURN = 1.2;    // % speed
-        static constexpr double SLOMO_MULTIPLIER = 0.3;     // % speed
+        static constexpr double CHASSIS_AUTO_FORWARD = 0.3;   // % speed
+        static constexpr double CHASSIS_AUTO_TURN = 1.2;      // % speed
+        static constexpr double SLOMO_MULTIPLIER = 0.3;       // % speed
+        static constexpr double CHASSIS_TUNE_AMPLITUDE = 0.3; // % speed
+
+        // Loop Periods
+        static constexpr uint32_t ODOM_PERIOD = 10;           // ms
+        static constexpr uint32_t DISPLAY_PERIOD = 50;        // ms
+        static constexpr uint32_t AUTO_LOOP_PERIOD = 20;      // ms
+        static constexpr uint32_t OPCONTROL_LOOP_PERIOD = 10; // ms
 
         // ADI Ports
         static constexpr std::initializer_list<uint8_t> OUTER_INTAKE_PNEUMATIC_PORTS = {5, 6};
@@ -312,6 +354,7 @@ namespace devils
         // Odometry
         DifferentialWheelOdometry wheelOdom = DifferentialWheelOdometry(leftSensor, rightSensor, WHEEL_RADIUS, WHEEL_BASE);
         // DifferentialWheelOdometry wheelOdom = DifferentialWheelOdometry(chassis, WHEEL_RADIUS, WHEEL_BASE);
+        SlipDetector slipDetector = SlipDetector(imu, wheelOdom);
 
         // Controller
         BlazeAutoController autoController = BlazeAutoController(chassis, wheelOdom);
@@ -326,6 +369,9 @@ namespace devils
                                        new AutoPickerRenderer({"Adam", "Sam", "Skills"}),
                                        new StatsRenderer()});
         StatsRenderer *statsRenderer = mainDisplay.getRenderer<StatsRenderer>();
+
+        // Tasks
+        Scheduler scheduler = Scheduler();
         AutoPickerRenderer *autoPickerRenderer = mainDisplay.getRenderer<AutoPickerRenderer>();
         PathRenderer *pathRenderer = mainDisplay.getRenderer<PathRenderer>();
     };
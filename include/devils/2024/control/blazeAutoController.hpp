@@ -23,7 +23,11 @@ namespace devils
             : pursuitController(chassis, odometry, &mainPath),
               ControllerList({&pursuitController}, false)
         {
-            pursuitController.setLookaheadDistance(6);
+            pursuitController.setLookaheadDistance(LOOKAHEAD_DISTANCE);
+
+            // Start actuating before arriving at the control point
+            pursuitController.setEventLead("fire", LOOKAHEAD_DISTANCE, FLYWHEEL_SPIN_UP_TIME);
+            pursuitController.setEventLead("lowerIntake", LOOKAHEAD_DISTANCE, PNEUMATIC_ACTUATION_TIME);
         }
 
         /**
@@ -50,6 +54,25 @@ namespace devils
             pathRenderer->setPath(_getPath());
         }
 
+        /**
+         * Replans around obstacles in the occupancy grid if the robot is pushed off the path.
+         * @param grid The occupancy grid of the field.
+         */
+        void useOccupancyGrid(OccupancyGrid grid)
+        {
+            occupancyGrid = grid;
+            pursuitController.useOccupancyGrid(occupancyGrid);
+        }
+
+        /**
+         * Replans back onto the path on the next update.
+         * Only has an effect when an occupancy grid is used.
+         */
+        void replan()
+        {
+            pursuitController.replan();
+        }
+
         /**
          * Enables or disables the skills path.
          * @param enable Whether to enable the skills path.
@@ -63,10 +86,15 @@ namespace devils
         }
 
     private:
+        static constexpr double LOOKAHEAD_DISTANCE = 6;         // in
+        static constexpr double FLYWHEEL_SPIN_UP_TIME = 800;    // ms
+        static constexpr double PNEUMATIC_ACTUATION_TIME = 250; // ms
+
         // Path
         GeneratedPath mainPath = PathGenerator::generateSpline(PathFileReader::deserialize(g_blazePathData));
         GeneratedPath skillsPath = PathGenerator::generateSpline(PathFileReader::deserialize(g_blazeSkillsData));
         bool isSkillsPath = false;
+        OccupancyGrid occupancyGrid;
 
         // Controllers
         PursuitController pursuitController;
@@ -24,9 +24,9 @@ namespace devils
             wheelOdom.setTicksPerRevolution(TICKS_PER_REVOLUTION);
             gps.setOffset(GPS_OFFSET_X, GPS_OFFSET_Y, GPS_OFFSET_ROTATION);
 
-            gps.runAsync();
-            wheelOdom.runAsync();
-            // fusedOdom.runAsync();
+            scheduler.add(gps, "PJ.GPS", GPS_PERIOD);
+            scheduler.add(wheelOdom, "PJ.Odom", ODOM_PERIOD);
+            // scheduler.add(fusedOdom, "PJ.FusedOdom", ODOM_PERIOD);
 
             // Display
             statsRenderer->useOdomSource(&fusedOdom);
@@ -34,7 +34,9 @@ namespace devils
             autoController.usePathRenderer(*pathRenderer);
             statsRenderer->useAutoPickerRenderer(autoPickerRenderer);
 
-            mainDisplay.runAsync();
+            // Run Tasks
+            scheduler.add(mainDisplay, "PJ.Display", DISPLAY_PERIOD);
+            scheduler.start();
         }
 
         void autonomous() override
@@ -49,7 +51,9 @@ namespace devils
             fusedOdom.setPose(*autoController.getStartingPose());
 
             // Set Speed
+            // Scale both sides together when saturated, so the controllers get the curvature they asked for
             chassis.setSpeed(CHASSIS_AUTO_FORWARD, CHASSIS_AUTO_TURN);
+            chassis.setDesaturationMode(TankChassis::PROPORTIONAL);
 
             // Calibrate IMU
             imu.calibrate();
@@ -64,6 +68,48 @@ namespace devils
             EventTimer pauseTimer = EventTimer();
             EventTimer bounceTimer = EventTimer();
 
+            // Event Handlers
+            EventDispatcher dispatcher;
+
+            // Wings
+            dispatcher.on("rightWing", [&](PathEvent &event)
+                          { wings.extendRight(); });
+            dispatcher.on("leftWing", [&](PathEvent &event)
+                          { wings.extendLeft(); });
+            dispatcher.on("closeWings", [&](PathEvent &event)
+                          { wings.retractRight(); wings.retractLeft(); });
+
+            // Lift
+            dispatcher.on("raiseLift", [&](PathEvent &event)
+                          { blocker.extend(); });
+            dispatcher.on("lowerLift", [&](PathEvent &event)
+                          { blocker.retract(); });
+
+            // Intake
+            dispatcher.on("intake", [&](PathEvent &event)
+                          { intake.intake(); });
+            dispatcher.on("outtake", [&](PathEvent &event)
+                          { intake.outtake(); });
+            dispatcher.on("stopIntake", [&](PathEvent &event)
+                          { intake.stop(); });
+
+            // Other
+            dispatcher.on("pause", [&](PathEvent &event)
+                          { pauseTimer.start(event.id, event.value); });
+            dispatcher.on("setSpeed", [&](PathEvent &event)
+                          { chassis.setSpeed(event.value * CHASSIS_AUTO_FORWARD, CHASSIS_AUTO_TURN); });
+            dispatcher.on("bounce", [&](PathEvent &event)
+                          { bounceTimer.start(event.id, event.value); });
+            dispatcher.on("alignToAngle", [&](PathEvent &event)
+                          {
+                              double angleRad = Units::degToRad(event.value);
+                              double deltaAngle = Units::diffRad(angleRad, imu.getHeading());
+
+                              bounceController.setRotation(deltaAngle);
+                              if (pauseTimer.getRunning())
+                                  chassis.move(0.0, deltaAngle); });
+
+            LoopRate rate("PJ.Autonomous", AUTO_LOOP_PERIOD);
             while (true)
             {
                 // Run Auto Controller
@@ -78,81 +124,10 @@ namespace devils
                 // mainController.set_text(0, 0, std::to_string(imu.getHeading()));
 
                 // Handle Auto Controller Events
-                PathEvents *events = autoController.getState().events;
-                for (PathEvent event : *events)
-                {
-                    // Post-Pause Events
-                    if (event.params == "afterPause" && pauseTimer.getRunning())
-                        continue;
-
-                    // Wings
-                    if (event.name == "rightWing")
-                    {
-                        wings.extendRight();
-                    }
-                    else if (event.name == "leftWing")
-                    {
-                        wings.extendLeft();
-                    }
-                    else if (event.name == "closeWings")
-                    {
-                        wings.retractRight();
-                        wings.retractLeft();
-                    }
-
-                    // Lift
-                    else if (event.name == "raiseLift")
-                    {
-                        blocker.extend();
-                    }
-                    else if (event.name == "lowerLift")
-                    {
-                        blocker.retract();
-                    }
-                    // Intake
-                    else if (event.name == "intake")
-                    {
-                        intake.intake();
-                    }
-                    else if (event.name == "outtake")
-                    {
-                        intake.outtake();
-                    }
-                    else if (event.name == "stopIntake")
-                    {
-                        intake.stop();
-                    }
-                    // Other
-                    else if (event.name == "pause")
-                    {
-                        pauseTimer.start(event.id, std::stoi(event.params));
-                    }
-                    else if (event.name == "setSpeed")
-                    {
-                        chassis.setSpeed(std::stod(event.params) * CHASSIS_AUTO_FORWARD, CHASSIS_AUTO_TURN);
-                    }
-                    else if (event.name == "bounce")
-                    {
-                        bounceTimer.start(event.id, std::stoi(event.params));
-                    }
-                    else if (event.name == "alignToAngle")
-                    {
-                        double angleDeg = std::stod(event.params);
-                        double angleRad = Units::degToRad(angleDeg);
-                        double deltaAngle = Units::diffRad(angleRad, imu.getHeading());
-
-                        bounceController.setRotation(deltaAngle);
-                        if (pauseTimer.getRunning())
-                            chassis.move(0.0, deltaAngle);
-                    }
-                    else
-                    {
-                        Logger::warn("Unknown Event: " + event.name);
-                    }
-                }
+                dispatcher.dispatch(*autoController.getState().events, pauseTimer.getRunning());
 
                 // Pause
-                pros::delay(20);
+                rate.wait();
             }
         }
 
@@ -160,11 +135,13 @@ namespace devils
         {
             // Reset Speed
             chassis.setSpeed(1.0, 1.0);
+            chassis.setDesaturationMode(TankChassis::CLAMP);
 
             // Controls
             bool isBlockerUp = false;
 
             // Loop
+            LoopRate rate("PJ.OpControl", OPCONTROL_LOOP_PERIOD);
             while (true)
             {
                 // Take Controller Inputs
@@ -206,8 +183,8 @@ namespace devils
 
                 // Vision Sensor
 
-                // Delay to prevent the CPU from being overloaded
-                pros::delay(10);
+                // Wait for the next period
+                rate.wait();
             }
         }
 
@@ -219,6 +196,10 @@ namespace devils
             blocker.retract(true); // Uncomment to auto-climb
             // wings.retractLeft(); // Need extended for auto win point
             // wings.retractRight(); // Need extended for auto win point
+
+            // Save Profile
+            Profiler::log();
+            Profiler::saveToSD();
         }
 
     private:
@@ -244,6 +225,13 @@ namespace devils
         static constexpr double CHASSIS_AUTO_FORWARD = 0.3;                   // % speed
         static constexpr double CHASSIS_AUTO_TURN = 1.0;                      // % speed
 
+        // Loop Periods
+        static constexpr uint32_t ODOM_PERIOD = 10;           // ms
+        static constexpr uint32_t GPS_PERIOD = 20;            // ms
+        static constexpr uint32_t DISPLAY_PERIOD = 50;        // ms
+        static constexpr uint32_t AUTO_LOOP_PERIOD = 20;      // ms
+        static constexpr uint32_t OPCONTROL_LOOP_PERIOD = 10; // ms
+
         // GPS Offset
         static constexpr double GPS_OFFSET_X = 0.0;         // in
         static constexpr double GPS_OFFSET_Y = 6.0;         // in
@@ -281,5 +269,8 @@ namespace devils
         PathRenderer *pathRenderer = mainDisplay.getRenderer<PathRenderer>();
         AutoPickerRenderer *autoPickerRenderer = mainDisplay.getRenderer<AutoPickerRenderer>();
         StatsRenderer *statsRenderer = mainDisplay.getRenderer<StatsRenderer>();
+
+        // Tasks
+        Scheduler scheduler = Scheduler();
     };
 }
\ No newline at end of file
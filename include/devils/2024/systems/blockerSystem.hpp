@@ -1,4 +1,5 @@
 #pragma once
+#include "../../command/subsystem.hpp"
 #include "../../hardware/scuffPneumatic.hpp"
 
 namespace devils
@@ -6,7 +7,7 @@ namespace devils
     /**
      * Controls the pneumatic blocker that pops out on top of the robot.
      */
-    class BlockerSystem
+    class BlockerSystem : public Subsystem
     {
     public:
         /**
@@ -1,4 +1,5 @@
 #pragma once
+#include "devils/command/subsystem.hpp"
 #include "devils/utils/logger.hpp"
 #include "devils/hardware/smartMotorGroup.hpp"
 #include "devils/hardware/opticalSensor.hpp"
@@ -9,7 +10,7 @@ namespace devils
     /**
      * Controls the intake system to intake triballs.
      */
-    class IntakeSystem
+    class IntakeSystem : public Subsystem
     {
     public:
         /**
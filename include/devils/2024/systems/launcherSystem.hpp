@@ -1,15 +1,17 @@
 #pragma once
+#include "../../command/subsystem.hpp"
 #include "../../hardware/smartMotor.hpp"
 #include "../../hardware/scuffPneumatic.hpp"
 #include "../../hardware/led.hpp"
-#include "../../utils/pid.hpp"
+#include "../../utils/flywheelController.hpp"
+#include "../../utils/relayTuner.hpp"
 
 namespace devils
 {
     /**
      * Controls the launcher system to launch triballs.
      */
-    class LauncherSystem
+    class LauncherSystem : public Subsystem
     {
     public:
         /**
@@ -22,38 +24,60 @@ namespace devils
             std::string name,
             const int8_t leftMotorPort,
             const int8_t rightMotorPort)
-            : leftMotor(name + ".LeftFlywheel", leftMotorPort),
-              rightMotor(name + ".RightFlywheel", rightMotorPort)
+            : name(name),
+              leftMotor(name + ".LeftFlywheel", leftMotorPort),
+              rightMotor(name + ".RightFlywheel", rightMotorPort),
+              leftFlywheel(name + ".LeftFlywheel", leftMotor, DEFAULT_KV, DEFAULT_TBH_GAIN),
+              rightFlywheel(name + ".RightFlywheel", rightMotor, DEFAULT_KV, DEFAULT_TBH_GAIN)
         {
             leftMotor.setBrakeMode(false);
             rightMotor.setBrakeMode(false);
+
+            // Start Flywheel Tasks
+            leftFlywheel.runAsync();
+            rightFlywheel.runAsync();
         }
 
         /**
-         * Runs the launcher flywheels using a closed-loop PID controller.
+         * Measures the flywheel feedforward and auto-tunes the take-back-half gain around the current setpoint.
+         * Saves the results to the SD card. Blocks for several seconds while the flywheels spin.
+         * @param voltage The voltage used to measure the feedforward, from 0 to 1.
          */
-        void firePID()
+        void tune(double voltage)
         {
-            // Current Velocity
-            double leftMotorVelocity = leftMotor.getVelocity();
-            double rightMotorVelocity = rightMotor.getVelocity();
+            leftFlywheel.disable();
+            rightFlywheel.disable();
 
-            // Target Velocity
-            double leftMotorSetpoint = flywheelSetpoint + deltaVelocity;
-            double rightMotorSetpoint = -flywheelSetpoint - deltaVelocity;
+            _tuneFlywheel(leftFlywheel, leftMotor, voltage, flywheelSetpoint);
+            _tuneFlywheel(rightFlywheel, rightMotor, -voltage, -flywheelSetpoint);
+            stop();
+        }
 
-            // Calculate PID
-            double leftMotorVoltage = flywheelLeftPID.update(leftMotorVelocity, leftMotorSetpoint);
-            double rightMotorVoltage = flywheelRightPID.update(rightMotorVelocity, rightMotorSetpoint);
+        /**
+         * Runs the launcher flywheels using the closed-loop flywheel controllers.
+         */
+        void firePID()
+        {
+            leftFlywheel.setSetpoint(flywheelSetpoint + deltaVelocity);
+            rightFlywheel.setSetpoint(-flywheelSetpoint - deltaVelocity);
 
             // Debug
             if (isAtSpeed())
                 debugLED.enable();
             else
                 debugLED.disable();
+        }
 
-            // Run Motors
-            fireVoltage(leftMotorVoltage, rightMotorVoltage);
+        /**
+         * Runs the launcher flywheels using the motors' onboard velocity controllers.
+         */
+        void fireVelocity()
+        {
+            leftFlywheel.disable();
+            rightFlywheel.disable();
+
+            leftMotor.moveVelocity(flywheelSetpoint + deltaVelocity);
+            rightMotor.moveVelocity(-flywheelSetpoint - deltaVelocity);
         }
 
         /**
@@ -63,6 +87,9 @@ namespace devils
          */
         void fireVoltage(double leftVoltage = 1.0, double rightVoltage = -1.0)
         {
+            leftFlywheel.disable();
+            rightFlywheel.disable();
+
             leftMotor.moveVoltage(leftVoltage);
             rightMotor.moveVoltage(rightVoltage);
         }
@@ -72,14 +99,13 @@ namespace devils
          */
         void stop()
         {
+            leftFlywheel.disable();
+            rightFlywheel.disable();
+
             leftMotor.stop();
             rightMotor.stop();
             debugLED.disable();
 
-            // Reset PID
-            flywheelLeftPID.reset();
-            flywheelRightPID.reset();
-
             isFiring = false;
         }
 
@@ -129,11 +155,12 @@ namespace devils
 
         /**
          * Gets the average velocity of the flywheel motors.
+         * Uses the velocities from the last flywheel update, so no device reads are made.
          */
         double getCurrentVelocity()
         {
-            double leftMotorVelocity = std::abs(leftMotor.getVelocity());
-            double rightMotorVelocity = std::abs(rightMotor.getVelocity());
+            double leftMotorVelocity = std::abs(leftFlywheel.getVelocity());
+            double rightMotorVelocity = std::abs(rightFlywheel.getVelocity());
             return (leftMotorVelocity + rightMotorVelocity) / 2;
         }
 
@@ -144,8 +171,8 @@ namespace devils
         bool isAtSpeed()
         {
             // Get Motor Velocities
-            double leftMotorDelta = std::abs(leftMotor.getVelocity()) - flywheelSetpoint;
-            double rightMotorDelta = std::abs(rightMotor.getVelocity()) - flywheelSetpoint;
+            double leftMotorDelta = std::abs(leftFlywheel.getVelocity()) - flywheelSetpoint;
+            double rightMotorDelta = std::abs(rightFlywheel.getVelocity()) - flywheelSetpoint;
 
             // Check if the motors are at speed
             bool leftAtSpeed = std::abs(leftMotorDelta) < AT_SPEED_RANGE;
@@ -154,21 +181,62 @@ namespace devils
             return leftAtSpeed && rightAtSpeed;
         }
 
+        /**
+         * Gets the left flywheel controller.
+         * @return The left flywheel controller.
+         */
+        FlywheelController &getLeftFlywheel()
+        {
+            return leftFlywheel;
+        }
+
+        /**
+         * Gets the right flywheel controller.
+         * @return The right flywheel controller.
+         */
+        FlywheelController &getRightFlywheel()
+        {
+            return rightFlywheel;
+        }
+
+        /**
+         * Measures the feedforward of a single flywheel, then relay-tunes its take-back-half gain.
+         * The integral gain of a relay-tuned PI loop is used, since take-back-half is a pure integrator.
+         * @param flywheel The flywheel controller to tune.
+         * @param motor The motor driving the flywheel.
+         * @param voltage The voltage used to measure the feedforward, from -1 to 1.
+         * @param setpoint The velocity to tune around, in RPM.
+         */
+        void _tuneFlywheel(FlywheelController &flywheel, IMotor &motor, double voltage, double setpoint)
+        {
+            double kV = flywheel.measureKV(voltage);
+            if (kV == 0)
+                return;
+
+            // Take-back-half integrates once per flywheel update, not once per tuner loop
+            auto gains = RelayTuner::tuneVelocity(motor, setpoint, kV * setpoint, TUNE_AMPLITUDE, true, flywheel.getUpdatePeriod());
+            if (gains.has_value())
+                flywheel.setTuning(kV, gains->i);
+        }
+
     private:
         static constexpr double AT_SPEED_RANGE = 15;             // RPM
         static constexpr double DEFAULT_FLYWHEEL_SETPOINT = 120; // rpm
         static constexpr double DEFAULT_DELTA = 0;               // rpm
-
-        PID flywheelLeftPID = PID(0.003, 0.0003, 0, 1.0);
-        PID flywheelRightPID = PID(0.003, 0.0003, 0, 1.0);
+        static constexpr double DEFAULT_KV = 0.0035;             // % voltage / rpm
+        static constexpr double DEFAULT_TBH_GAIN = 0.0003;       // % voltage / rpm
+        static constexpr double TUNE_AMPLITUDE = 0.2;            // %
 
         double flywheelSetpoint = DEFAULT_FLYWHEEL_SETPOINT;
         double deltaVelocity = DEFAULT_DELTA; // Difference between left and right motor speeds
         bool isFiring = false;
         int startTime = 0;
 
+        std::string name;
         SmartMotor leftMotor;
         SmartMotor rightMotor;
+        FlywheelController leftFlywheel;
+        FlywheelController rightFlywheel;
         LED debugLED = LED("DebugLED", 1);
     };
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include "../../command/subsystem.hpp"
 #include "../../hardware/scuffPneumatic.hpp"
 
 namespace devils
@@ -6,7 +7,7 @@ namespace devils
     /**
      * Controls the pneumatic wings that pop out to the sides of the robot.
      */
-    class WingSystem
+    class WingSystem : public Subsystem
     {
     public:
         /**
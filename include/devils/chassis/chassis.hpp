@@ -1,4 +1,5 @@
 #pragma once
+#include "../command/subsystem.hpp"
 #include <algorithm>
 
 namespace devils
@@ -6,7 +7,7 @@ namespace devils
     /**
      * Represents a base chassis. A chassis is a robot's drivetrain.
      */
-    struct BaseChassis
+    struct BaseChassis : public Subsystem
     {
         /**
          * Moves the robot in a direction using voltage.
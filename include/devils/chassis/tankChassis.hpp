@@ -1,6 +1,9 @@
 #pragma once
 #include "chassis.hpp"
 #include "../hardware/smartMotorGroup.hpp"
+#include "../hardware/battery.hpp"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <iostream>
 #include "../utils/logger.hpp"
@@ -13,6 +16,19 @@ namespace devils
     class TankChassis : public BaseChassis
     {
     public:
+        /**
+         * Represents how wheel speeds are limited when `forward + turn` exceeds full power.
+         */
+        enum DesaturationMode
+        {
+            /// @brief Clamps each side independently. Distorts the turn ratio when saturated.
+            CLAMP,
+            /// @brief Scales both sides by the same factor, preserving the turn ratio.
+            PROPORTIONAL,
+            /// @brief Keeps the full turn and gives the remaining power to forward.
+            TURN_PRIORITY
+        };
+
         /**
          * Creates a new tank chassis.
          * @param name The name of the chassis (for logging purposes)
@@ -50,11 +66,74 @@ namespace devils
          */
         void moveTank(double left, double right)
         {
-            double fixedLeft = std::clamp(left, -1.0, 1.0);
-            double fixedRight = std::clamp(right, -1.0, 1.0);
+            _desaturate(left, right);
+
+            // Velocity Mode
+            if (maxVelocity > 0)
+            {
+                leftMotors.moveVelocity(left * maxVelocity);
+                rightMotors.moveVelocity(right * maxVelocity);
+                return;
+            }
 
-            leftMotors.moveVoltage(fixedLeft);
-            rightMotors.moveVoltage(fixedRight);
+            leftMotors.moveVoltage(left);
+            rightMotors.moveVoltage(right);
+        }
+
+        /**
+         * Runs the chassis using the motors' onboard velocity controllers instead of voltage.
+         * Speeds from -1 to 1 are scaled to the maximum velocity.
+         * @param maxVelocity The velocity of the motors at full speed in RPM, or 0 to use voltage mode.
+         */
+        void useVelocityMode(double maxVelocity)
+        {
+            this->maxVelocity = maxVelocity;
+        }
+
+        /**
+         * Sets how wheel speeds are limited when they exceed full power.
+         * @param mode The desaturation mode. Defaults to `CLAMP`.
+         */
+        void setDesaturationMode(DesaturationMode mode)
+        {
+            desaturationMode = mode;
+        }
+
+        /**
+         * Limits the left and right speeds using the current `DesaturationMode`.
+         * In voltage mode, the limit is the largest speed that still fits after battery compensation, so the motors never clamp it again.
+         * @param left The speed of the left side. Modified in place.
+         * @param right The speed of the right side. Modified in place.
+         */
+        void _desaturate(double &left, double &right)
+        {
+            double limit = maxVelocity > 0 ? 1.0 : 1.0 / std::max(Battery::getCompensation(), 1.0);
+            switch (desaturationMode)
+            {
+            case CLAMP:
+                left = std::clamp(left, -limit, limit);
+                right = std::clamp(right, -limit, limit);
+                break;
+            case PROPORTIONAL:
+            {
+                double maxSpeed = std::max(std::abs(left), std::abs(right));
+                if (maxSpeed > limit)
+                {
+                    left *= limit / maxSpeed;
+                    right *= limit / maxSpeed;
+                }
+                break;
+            }
+            case TURN_PRIORITY:
+            {
+                double turn = std::clamp((left - right) * 0.5, -limit, limit);
+                double maxForward = limit - std::abs(turn);
+                double forward = std::clamp((left + right) * 0.5, -maxForward, maxForward);
+                left = forward + turn;
+                right = forward - turn;
+                break;
+            }
+            }
         }
 
         /**
@@ -87,6 +166,9 @@ namespace devils
     private:
         static constexpr bool USE_BRAKE_MODE = false;
 
+        DesaturationMode desaturationMode = CLAMP;
+        double maxVelocity = 0; // RPM
+
         SmartMotorGroup leftMotors;
         SmartMotorGroup rightMotors;
     };
@@ -0,0 +1,166 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "command.hpp"
+#include "../control/autoController.hpp"
+#include "../chassis/chassis.hpp"
+#include <functional>
+#include <initializer_list>
+
+namespace devils
+{
+    /**
+     * Runs a function once and finishes immediately.
+     */
+    class InstantCommand : public Command
+    {
+    public:
+        /**
+         * Creates a new instant command.
+         * @param action The function to run.
+         * @param requirements The subsystems the function controls.
+         */
+        InstantCommand(std::function<void()> action, std::initializer_list<Subsystem *> requirements = {})
+            : action(action)
+        {
+            for (Subsystem *subsystem : requirements)
+                addRequirement(*subsystem);
+        }
+
+        void initialize() override
+        {
+            action();
+        }
+
+        bool isFinished() override
+        {
+            return true;
+        }
+
+    private:
+        std::function<void()> action;
+    };
+
+    /**
+     * Runs a function every update until interrupted.
+     */
+    class RunCommand : public Command
+    {
+    public:
+        /**
+         * Creates a new run command.
+         * @param action The function to run every update.
+         * @param requirements The subsystems the function controls.
+         */
+        RunCommand(std::function<void()> action, std::initializer_list<Subsystem *> requirements = {})
+            : action(action)
+        {
+            for (Subsystem *subsystem : requirements)
+                addRequirement(*subsystem);
+        }
+
+        void execute() override
+        {
+            action();
+        }
+
+    private:
+        std::function<void()> action;
+    };
+
+    /**
+     * Waits for a duration before finishing.
+     */
+    class WaitCommand : public Command
+    {
+    public:
+        /**
+         * Creates a new wait command.
+         * @param duration The time to wait in milliseconds.
+         */
+        WaitCommand(uint32_t duration)
+            : duration(duration)
+        {
+        }
+
+        void initialize() override
+        {
+            startTime = pros::millis();
+        }
+
+        bool isFinished() override
+        {
+            return pros::millis() - startTime >= duration;
+        }
+
+    private:
+        uint32_t duration;
+        uint32_t startTime = 0;
+    };
+
+    /**
+     * Waits until a condition is true before finishing.
+     */
+    class WaitUntilCommand : public Command
+    {
+    public:
+        /**
+         * Creates a new wait until command.
+         * @param condition The condition to wait for.
+         */
+        WaitUntilCommand(std::function<bool()> condition)
+            : condition(condition)
+        {
+        }
+
+        bool isFinished() override
+        {
+            return condition();
+        }
+
+    private:
+        std::function<bool()> condition;
+    };
+
+    /**
+     * Runs an `AutoController` as a command that requires the chassis.
+     */
+    class AutoControllerCommand : public Command
+    {
+    public:
+        /**
+         * Creates a new auto controller command.
+         * @param controller The controller to run.
+         * @param chassis The chassis the controller drives. Stopped when the command ends.
+         */
+        AutoControllerCommand(AutoController &controller, BaseChassis &chassis)
+            : controller(controller),
+              chassis(chassis)
+        {
+            addRequirement(chassis);
+        }
+
+        void initialize() override
+        {
+            controller.reset();
+        }
+
+        void execute() override
+        {
+            controller.update();
+        }
+
+        void end(bool isInterrupted) override
+        {
+            chassis.stop();
+        }
+
+        bool isFinished() override
+        {
+            return controller.getFinished();
+        }
+
+    private:
+        AutoController &controller;
+        BaseChassis &chassis;
+    };
+}
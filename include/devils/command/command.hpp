@@ -0,0 +1,86 @@
+#pragma once
+#include "subsystem.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Represents an action that runs over time and requires a set of subsystems.
+     * Commands are run by the `CommandScheduler` or by a command group.
+     */
+    struct Command
+    {
+        virtual ~Command() = default;
+
+        /**
+         * Called once when the command is scheduled.
+         */
+        virtual void initialize() {}
+
+        /**
+         * Called periodically while the command is scheduled.
+         */
+        virtual void execute() {}
+
+        /**
+         * Called once when the command finishes or is interrupted.
+         * @param isInterrupted True if the command was interrupted before it finished.
+         */
+        virtual void end(bool isInterrupted) {}
+
+        /**
+         * Checks if the command is finished.
+         * @return True if the command is finished, false otherwise.
+         */
+        virtual bool isFinished()
+        {
+            return false;
+        }
+
+        /**
+         * Adds a subsystem that the command requires.
+         * @param subsystem The subsystem to require.
+         */
+        void addRequirement(Subsystem &subsystem)
+        {
+            if (!hasRequirement(&subsystem))
+                requirements.push_back(&subsystem);
+        }
+
+        /**
+         * Checks if the command requires a subsystem.
+         * @param subsystem The subsystem to check.
+         * @return True if the command requires the subsystem, false otherwise.
+         */
+        bool hasRequirement(Subsystem *subsystem)
+        {
+            return std::find(requirements.begin(), requirements.end(), subsystem) != requirements.end();
+        }
+
+        /**
+         * Checks if the command shares any required subsystem with another command.
+         * @param other The other command.
+         * @return True if the commands conflict, false otherwise.
+         */
+        bool conflictsWith(Command &other)
+        {
+            for (Subsystem *subsystem : requirements)
+                if (other.hasRequirement(subsystem))
+                    return true;
+            return false;
+        }
+
+        /**
+         * Gets the subsystems the command requires.
+         * @return The required subsystems.
+         */
+        std::vector<Subsystem *> &getRequirements()
+        {
+            return requirements;
+        }
+
+    protected:
+        std::vector<Subsystem *> requirements;
+    };
+}
@@ -0,0 +1,206 @@
+#pragma once
+#include "command.hpp"
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Base class for commands made of other commands.
+     * Requires every subsystem required by its children.
+     */
+    struct CommandGroup : public Command
+    {
+        /**
+         * Creates a new command group.
+         * @param commands The commands in the group.
+         */
+        CommandGroup(std::initializer_list<Command *> commands)
+            : commands(commands)
+        {
+            for (Command *command : this->commands)
+                for (Subsystem *subsystem : command->getRequirements())
+                    addRequirement(*subsystem);
+        }
+
+    protected:
+        /**
+         * Checks that no two commands in the group require the same subsystem.
+         * Used by groups that run their commands at the same time, where shared requirements would fight.
+         */
+        void _checkRequirementsDisjoint()
+        {
+            for (int i = 0; i < commands.size(); i++)
+                for (int j = i + 1; j < commands.size(); j++)
+                    if (commands[i]->conflictsWith(*commands[j]))
+                        throw std::invalid_argument("Commands in a parallel group cannot share a requirement");
+        }
+
+        std::vector<Command *> commands;
+    };
+
+    /**
+     * Runs commands one after another.
+     */
+    class SequentialGroup : public CommandGroup
+    {
+    public:
+        /**
+         * Creates a new sequential group.
+         * @param commands The commands to run in order.
+         */
+        SequentialGroup(std::initializer_list<Command *> commands)
+            : CommandGroup(commands)
+        {
+        }
+
+        void initialize() override
+        {
+            currentIndex = 0;
+            if (!commands.empty())
+                commands[0]->initialize();
+        }
+
+        void execute() override
+        {
+            if (isFinished())
+                return;
+
+            Command *command = commands[currentIndex];
+            command->execute();
+            if (!command->isFinished())
+                return;
+
+            // Next Command
+            command->end(false);
+            currentIndex++;
+            if (!isFinished())
+                commands[currentIndex]->initialize();
+        }
+
+        void end(bool isInterrupted) override
+        {
+            if (isInterrupted && !isFinished())
+                commands[currentIndex]->end(true);
+        }
+
+        bool isFinished() override
+        {
+            return currentIndex >= commands.size();
+        }
+
+    private:
+        int currentIndex = 0;
+    };
+
+    /**
+     * Runs commands at the same time until all of them finish.
+     */
+    class ParallelGroup : public CommandGroup
+    {
+    public:
+        /**
+         * Creates a new parallel group.
+         * @param commands The commands to run at the same time. Must not share any requirements.
+         */
+        ParallelGroup(std::initializer_list<Command *> commands)
+            : CommandGroup(commands),
+              isRunning(commands.size(), false)
+        {
+            _checkRequirementsDisjoint();
+        }
+
+        void initialize() override
+        {
+            for (int i = 0; i < commands.size(); i++)
+            {
+                commands[i]->initialize();
+                isRunning[i] = true;
+            }
+        }
+
+        void execute() override
+        {
+            for (int i = 0; i < commands.size(); i++)
+            {
+                if (!isRunning[i])
+                    continue;
+
+                commands[i]->execute();
+                if (commands[i]->isFinished())
+                {
+                    commands[i]->end(false);
+                    isRunning[i] = false;
+                }
+            }
+        }
+
+        void end(bool isInterrupted) override
+        {
+            for (int i = 0; i < commands.size(); i++)
+            {
+                if (isRunning[i])
+                    commands[i]->end(true);
+                isRunning[i] = false;
+            }
+        }
+
+        bool isFinished() override
+        {
+            return std::find(isRunning.begin(), isRunning.end(), true) == isRunning.end();
+        }
+
+    private:
+        std::vector<bool> isRunning;
+    };
+
+    /**
+     * Runs commands at the same time until any one of them finishes.
+     * The remaining commands are interrupted.
+     */
+    class RaceGroup : public CommandGroup
+    {
+    public:
+        /**
+         * Creates a new race group.
+         * @param commands The commands to race. Must not share any requirements.
+         */
+        RaceGroup(std::initializer_list<Command *> commands)
+            : CommandGroup(commands)
+        {
+            _checkRequirementsDisjoint();
+        }
+
+        void initialize() override
+        {
+            isAnyFinished = false;
+            for (Command *command : commands)
+                command->initialize();
+        }
+
+        void execute() override
+        {
+            for (Command *command : commands)
+            {
+                command->execute();
+                if (command->isFinished())
+                    isAnyFinished = true;
+            }
+        }
+
+        void end(bool isInterrupted) override
+        {
+            for (Command *command : commands)
+                command->end(!command->isFinished());
+        }
+
+        bool isFinished() override
+        {
+            return isAnyFinished;
+        }
+
+    private:
+        bool isAnyFinished = false;
+    };
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "command.hpp"
+#include "../utils/runnable.hpp"
+#include "../utils/logger.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Runs scheduled commands each update.
+     * Scheduling a command interrupts any running command that requires the same subsystem.
+     */
+    class CommandScheduler : public Runnable
+    {
+    public:
+        /**
+         * Schedules a command, interrupting any running commands that share its requirements.
+         * Does nothing if the command is already scheduled.
+         * @param command The command to schedule.
+         */
+        void schedule(Command &command)
+        {
+            if (isScheduled(command))
+                return;
+
+            // Interrupt Conflicts
+            for (int i = runningCommands.size() - 1; i >= 0; i--)
+            {
+                Command *runningCommand = runningCommands[i];
+                if (!runningCommand->conflictsWith(command))
+                    continue;
+
+                if (LOGGING_ENABLED)
+                    Logger::debug("CommandScheduler: Interrupted a command with a conflicting requirement");
+                runningCommands.erase(runningCommands.begin() + i);
+                runningCommand->end(true);
+            }
+
+            // Start Command
+            command.initialize();
+            runningCommands.push_back(&command);
+        }
+
+        /**
+         * Executes each running command and removes the ones that have finished.
+         */
+        void update() override
+        {
+            // Commands can schedule or cancel other commands while they execute, so run from a copy
+            std::vector<Command *> commands = runningCommands;
+            for (Command *command : commands)
+            {
+                // Skip commands interrupted earlier in this update
+                if (!isScheduled(*command))
+                    continue;
+
+                command->execute();
+                if (!command->isFinished())
+                    continue;
+
+                // The command may have been interrupted by something it scheduled
+                auto entry = std::find(runningCommands.begin(), runningCommands.end(), command);
+                if (entry == runningCommands.end())
+                    continue;
+                runningCommands.erase(entry);
+                command->end(false);
+            }
+        }
+
+        /**
+         * Interrupts a running command.
+         * @param command The command to interrupt.
+         */
+        void cancel(Command &command)
+        {
+            auto entry = std::find(runningCommands.begin(), runningCommands.end(), &command);
+            if (entry == runningCommands.end())
+                return;
+
+            runningCommands.erase(entry);
+            command.end(true);
+        }
+
+        /**
+         * Interrupts all running commands.
+         */
+        void cancelAll()
+        {
+            std::vector<Command *> commands = runningCommands;
+            runningCommands.clear();
+            for (Command *command : commands)
+                command->end(true);
+        }
+
+        /**
+         * Checks if a command is running.
+         * @param command The command to check.
+         * @return True if the command is running, false otherwise.
+         */
+        bool isScheduled(Command &command)
+        {
+            return std::find(runningCommands.begin(), runningCommands.end(), &command) != runningCommands.end();
+        }
+
+        /**
+         * Checks if any commands are running.
+         * @return True if no commands are running, false otherwise.
+         */
+        bool isIdle()
+        {
+            return runningCommands.empty();
+        }
+
+    private:
+        static constexpr bool LOGGING_ENABLED = false;
+
+        std::vector<Command *> runningCommands;
+    };
+}
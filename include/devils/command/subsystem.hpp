@@ -0,0 +1,13 @@
+#pragma once
+
+namespace devils
+{
+    /**
+     * Represents a part of the robot that can only be controlled by one command at a time.
+     * Commands list the subsystems they require so the `CommandScheduler` can interrupt conflicting commands.
+     */
+    struct Subsystem
+    {
+        virtual ~Subsystem() = default;
+    };
+}
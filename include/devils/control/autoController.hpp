@@ -3,7 +3,9 @@
 #include "pros/rtos.hpp"
 #include "../geometry/pose.hpp"
 #include "../utils/runnable.hpp"
+#include "../utils/profiler.hpp"
 #include "../path/pathFile.hpp"
+#include <algorithm>
 
 namespace devils
 {
@@ -21,6 +23,7 @@ namespace devils
             PathEvents *events = &NO_EVENTS;
             bool isFinished = false;
             std::string debugText = "";
+            double exitSpeed = 0; // The forward speed the controller was driving at, handed to the next controller
         };
 
         /**
@@ -32,6 +35,19 @@ namespace devils
             currentState.isFinished = false;
             currentState.target = nullptr;
             currentState.events = &NO_EVENTS;
+            currentState.exitSpeed = 0;
+            entrySpeed = 0;
+        }
+
+        /**
+         * Sets the speed the previous motion finished at, so the controller can continue without stopping.
+         * Should be called after `reset`.
+         * @param speed The forward speed from -1 to 1.
+         */
+        virtual void setEntrySpeed(double speed)
+        {
+            entrySpeed = speed;
+            entryTime = pros::millis();
         }
 
         /**
@@ -67,10 +83,11 @@ namespace devils
         void runSync() override
         {
             reset();
+            LoopRate rate("AutoController", 20);
             while (!getFinished())
             {
                 update();
-                pros::delay(20);
+                rate.wait();
             }
         }
 
@@ -84,10 +101,39 @@ namespace devils
                               { runSync(); });
         }
 
+        /**
+         * Gets the minimum forward speed carried over from the previous motion.
+         * Blends down to 0 over `ENTRY_BLEND_TIME` so the controller takes over smoothly.
+         * @return The forward speed from -1 to 1.
+         */
+        double _getEntrySpeed()
+        {
+            double blend = 1.0 - (pros::millis() - entryTime) / ENTRY_BLEND_TIME;
+            return entrySpeed * std::clamp(blend, 0.0, 1.0);
+        }
+
+        /**
+         * Raises a forward speed to the speed carried over from the previous motion, if both are in the same direction.
+         * @param forward The forward speed from -1 to 1.
+         * @return The forward speed from -1 to 1.
+         */
+        double _applyEntrySpeed(double forward)
+        {
+            double speed = _getEntrySpeed();
+            if (speed > 0 && forward >= 0)
+                return std::max(forward, speed);
+            if (speed < 0 && forward <= 0)
+                return std::min(forward, speed);
+            return forward;
+        }
+
     protected:
         static std::vector<PathEvent> NO_EVENTS;
+        static constexpr double ENTRY_BLEND_TIME = 300; // ms
 
         State currentState;
+        double entrySpeed = 0;
+        uint32_t entryTime = 0;
     };
 
     typedef AutoController::State AutoState;
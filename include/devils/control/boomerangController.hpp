@@ -0,0 +1,229 @@
+#pragma once
+#include "../chassis/chassis.hpp"
+#include "../odom/odomSource.hpp"
+#include "../utils/pid.hpp"
+#include "../utils/tuningFile.hpp"
+#include "../geometry/units.hpp"
+#include "autoController.hpp"
+#include "settleDetector.hpp"
+#include "pros/rtos.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace devils
+{
+    /**
+     * Controller for driving to a pose, including its final heading, in one continuous motion.
+     * Drives towards a carrot point placed behind the target along its heading,
+     * which pulls the robot onto the target heading as it approaches.
+     */
+    class BoomerangController : public AutoController
+    {
+    public:
+        /**
+         * Constructs a new BoomerangController.
+         * @param chassis The chassis to control.
+         * @param odometry The odometry source to use.
+         */
+        BoomerangController(BaseChassis &chassis, OdomSource &odometry)
+            : chassis(chassis),
+              odometry(odometry)
+        {
+            TuningFile::loadPID("Chassis.Translation", translationPID);
+            TuningFile::loadPID("Chassis.Rotation", rotationPID);
+        }
+
+        void reset() override
+        {
+            AutoController::reset();
+            currentState.target = targetPose;
+            translationPID.reset();
+            rotationPID.reset();
+            settleDetector.reset();
+        }
+
+        void update() override
+        {
+            ScopedTimer timer(updateProfile);
+
+            if (targetPose == nullptr || currentState.isFinished)
+                return;
+
+            // Get Current Pose
+            Pose currentPose = odometry.getSnapshot().getPose();
+            double distanceToTarget = currentPose.distanceTo(*targetPose);
+
+            // Carrot Point
+            double carrotDistance = isReversed ? -lead * distanceToTarget : lead * distanceToTarget;
+            double carrotX = targetPose->x - carrotDistance * cos(targetPose->rotation);
+            double carrotY = targetPose->y - carrotDistance * sin(targetPose->rotation);
+
+            // Errors
+            double deltaX = carrotX - currentPose.x;
+            double deltaY = carrotY - currentPose.y;
+            double deltaForward = cos(currentPose.rotation) * deltaX + sin(currentPose.rotation) * deltaY;
+            double deltaRotation = Units::diffRad(atan2(deltaY, deltaX), currentPose.rotation);
+            if (isReversed)
+                deltaRotation = Units::diffRad(deltaRotation, M_PI);
+
+            // Final Heading
+            // The carrot collapses onto the target when close, so steer to the target heading instead
+            bool isClose = distanceToTarget < FINAL_HEADING_DISTANCE;
+            double deltaHeading = Units::diffRad(targetPose->rotation, currentPose.rotation);
+            if (isClose)
+                deltaRotation = deltaHeading;
+
+            // Early Exit
+            if (earlyExitDistance > 0 && distanceToTarget < earlyExitDistance)
+            {
+                currentState.isFinished = true;
+                return;
+            }
+
+            // Settle
+            // Distance only counts as in band once the heading is also within `settleAngle`
+            bool isHeadingSettled = std::abs(deltaHeading) < settleAngle;
+            if (settleDetector.update(isHeadingSettled ? distanceToTarget : INFINITY))
+            {
+                currentState.isFinished = true;
+                currentState.exitSpeed = 0;
+                chassis.stop();
+                return;
+            }
+
+            // Calculate PID
+            double forward = translationPID.update(-deltaForward);
+            double turn = rotationPID.update(-deltaRotation);
+
+            // Slow down while facing away from the carrot
+            forward *= std::abs(cos(isClose ? 0 : deltaRotation));
+
+            // Keep speed up when chaining into the next motion
+            if (earlyExitDistance > 0)
+                forward = std::copysign(std::max(std::abs(forward), minSpeed), isReversed ? -1.0 : 1.0);
+
+            // Clamp Values
+            // Near the target, allow backing up to correct an overshoot
+            if (isClose && earlyExitDistance <= 0)
+                forward = std::clamp(forward, -maxSpeed, maxSpeed);
+            else if (isReversed)
+                forward = std::clamp(forward, -maxSpeed, 0.0);
+            else
+                forward = std::clamp(forward, 0.0, maxSpeed);
+            turn = std::clamp(turn, -1.0, 1.0);
+
+            // Carry Speed From Previous Motion
+            forward = _applyEntrySpeed(forward);
+            currentState.exitSpeed = forward;
+
+            // Drive
+            chassis.move(forward, turn);
+        }
+
+        /**
+         * Sets the target pose for the controller.
+         * @param targetPose The pose to drive to. The robot finishes facing `targetPose.rotation`.
+         */
+        void setTargetPose(Pose &targetPose)
+        {
+            this->targetPose = &targetPose;
+            currentState.target = &targetPose;
+        }
+
+        /**
+         * Sets whether the robot drives to the pose in reverse.
+         * @param isReversed Whether the robot is driving in reverse.
+         */
+        void setReverse(bool isReversed)
+        {
+            this->isReversed = isReversed;
+        }
+
+        /**
+         * Sets how far behind the target the carrot point is placed.
+         * Higher values make wider arcs that settle on the heading earlier.
+         * @param lead The carrot distance as a fraction of the distance to the target, from 0 to 1.
+         */
+        void setLead(double lead)
+        {
+            this->lead = std::clamp(lead, 0.0, 1.0);
+        }
+
+        /**
+         * Sets the maximum forward speed.
+         * @param maxSpeed The maximum forward speed from 0 to 1.
+         */
+        void setMaxSpeed(double maxSpeed)
+        {
+            this->maxSpeed = maxSpeed;
+        }
+
+        /**
+         * Sets when the robot is considered settled on the target.
+         * @param distance The maximum distance from the target in inches.
+         * @param angle The maximum heading error in radians.
+         * @param time The time the robot must stay within both thresholds in milliseconds.
+         * @param speed The maximum speed towards the target in inches per second.
+         */
+        void setSettleThresholds(double distance, double angle, double time, double speed = DEFAULT_SETTLE_SPEED)
+        {
+            settleAngle = angle;
+            settleDetector.setThresholds(distance, speed, time);
+        }
+
+        /**
+         * Sets the maximum time to spend on the motion before finishing anyway.
+         * Defaults to `DEFAULT_TIMEOUT`, so a motion that never settles cannot stall the autonomous.
+         * @param timeout The timeout in milliseconds, or -1 to disable.
+         */
+        void setTimeout(double timeout)
+        {
+            settleDetector.setTimeout(timeout);
+        }
+
+        /**
+         * Finishes as soon as the robot is within a distance of the target, without stopping the chassis.
+         * Used to chain into the next motion at speed. The final heading is not reached in this mode.
+         * @param distance The distance from the target to finish at in inches, or 0 to disable.
+         * @param minSpeed The minimum forward speed to hold while approaching, from 0 to 1.
+         */
+        void setEarlyExit(double distance, double minSpeed = DEFAULT_EXIT_SPEED)
+        {
+            earlyExitDistance = distance;
+            this->minSpeed = minSpeed;
+        }
+
+    private:
+        inline static ProfileSite updateProfile = ProfileSite("BoomerangController.update");
+
+        // Constants
+        static constexpr double DEFAULT_LEAD = 0.6;
+        static constexpr double DEFAULT_EXIT_SPEED = 0.3;
+        static constexpr double FINAL_HEADING_DISTANCE = 6;       // in
+        static constexpr double DEFAULT_SETTLE_DISTANCE = 1;      // in
+        static constexpr double DEFAULT_SETTLE_ANGLE = M_PI / 36; // rads
+        static constexpr double DEFAULT_SETTLE_TIME = 150;        // ms
+        static constexpr double DEFAULT_SETTLE_SPEED = 2;         // in/s
+        static constexpr double DEFAULT_TIMEOUT = 4000;           // ms
+
+        // PID
+        PID translationPID = PID(0.18, 0, 0); // <-- Translation
+        PID rotationPID = PID(0.8, 0, 0);     // <-- Rotation
+
+        // Object Handles
+        BaseChassis &chassis;
+        OdomSource &odometry;
+
+        // Settings
+        double lead = DEFAULT_LEAD;
+        double maxSpeed = 1.0;
+        double settleAngle = DEFAULT_SETTLE_ANGLE;
+        double earlyExitDistance = 0;
+        double minSpeed = DEFAULT_EXIT_SPEED;
+
+        // State
+        Pose *targetPose = nullptr;
+        bool isReversed = false;
+        SettleDetector settleDetector = SettleDetector(DEFAULT_SETTLE_DISTANCE, DEFAULT_SETTLE_SPEED, DEFAULT_SETTLE_TIME, DEFAULT_TIMEOUT);
+    };
+}
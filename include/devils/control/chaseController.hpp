@@ -43,8 +43,10 @@ namespace devils
 
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+
             // Get Current State
-            Pose currentPose = odometry.getPose();
+            Pose currentPose = odometry.getSnapshot().getPose();
             auto visionObjects = visionSensor.getObjects();
 
             // Get Objects within Area
@@ -100,7 +102,7 @@ namespace devils
         bool hasObjectsInVision()
         {
             // Get Current State
-            Pose currentPose = odometry.getPose();
+            Pose currentPose = odometry.getSnapshot().getPose();
             auto visionObjects = visionSensor.getObjects();
 
             // Get Objects within Area
@@ -151,6 +153,8 @@ namespace devils
         }
 
     private:
+        inline static ProfileSite updateProfile = ProfileSite("ChaseController.update");
+
         // Constants
         static constexpr double COLLECTION_DISTANCE = 12.0; // in
         static constexpr double OPTICAL_PROXIMITY = 0.9;    // %
@@ -45,8 +45,10 @@ namespace devils
 
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+
             // Get Current State
-            Pose currentPose = odometry.getPose();
+            Pose currentPose = odometry.getSnapshot().getPose();
             std::vector<GameObject> *gameObjects = gameObjectManager.getGameObjects();
 
             // Get the closest object
@@ -142,7 +144,7 @@ namespace devils
         GameObject *_getClosestObject()
         {
             // Get Current State
-            Pose currentPose = odometry.getPose();
+            Pose currentPose = odometry.getSnapshot().getPose();
             std::vector<GameObject> *gameObjects = gameObjectManager.getGameObjects();
 
             // Get the closest object
@@ -168,6 +170,8 @@ namespace devils
         }
 
     private:
+        inline static ProfileSite updateProfile = ProfileSite("CollectionController.update");
+
         // Constants
         static constexpr double CHASE_DISTANCE = 18.0;     // in
         static constexpr double COLLECTION_DISTANCE = 4.0; // in
@@ -32,15 +32,20 @@ namespace devils
 
         void reset() override
         {
+            _compile();
             AutoController::reset();
             startTime = pros::millis();
             controllerIndex = 0;
             for (AutoController *controller : controllers)
                 controller->reset();
+            _syncState();
         }
 
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+            _compile();
+
             // Start the timeout timer
             if (startTime < 0)
                 startTime = pros::millis();
@@ -49,76 +54,51 @@ namespace devils
             if (getFinished())
                 return;
 
+            // Check for Timeout
+            if (timeout > 0 && pros::millis() - startTime > timeout)
+            {
+                currentState.isFinished = true;
+                return;
+            }
+
             // Update the current controller
             AutoController *controller = getCurrentController();
             if (controller != nullptr)
             {
                 controller->update();
+                _syncState();
                 if (controller->getFinished())
                     skip();
             }
         }
 
-        void runSync() override
-        {
-            reset();
-            while (!getFinished())
-            {
-                getCurrentController()->reset();
-                getCurrentController()->runSync();
-                skip();
-                pros::delay(20);
-            }
-        }
-
-        AutoController::State &getState() override
-        {
-            // Update State
-            AutoController *controller = getCurrentController();
-            if (controller != nullptr)
-            {
-                AutoState &currentControllerState = controller->getState();
-                currentState.target = currentControllerState.target;
-                currentState.events = currentControllerState.events;
-                currentState.debugText = currentControllerState.debugText;
-            }
-            else
-            {
-                currentState.target = nullptr;
-                currentState.events = &NO_EVENTS;
-            }
-
-            // Check for Timeout
-            if (timeout > 0 && pros::millis() - startTime > timeout)
-                currentState.isFinished = true;
-
-            return currentState;
-        }
-
         /**
          * Gets the current working controller.
-         * @param searchChildren Recursively runs `getCurrentController` on each `ControllerList`.
-         * @return The current controller
+         * @param searchChildren Recursively gets the current controller of each nested `ControllerList`.
+         * @return The current controller or nullptr if the list is empty.
          */
         AutoController *getCurrentController(bool searchChildren = false)
         {
-            AutoController *currentController = controllers[controllerIndex % controllers.size()];
+            if (controllers.empty())
+                return nullptr;
+            int index = controllerIndex % controllers.size();
 
             // Abort if not searching children
             if (!searchChildren)
-                return currentController;
+                return controllers[index];
 
-            // Loop through controller lists
-            // Exits if it ever finds this controller
-            ControllerList *list = nullptr;
-            do
+            // Walk the compiled child lists
+            _compile();
+            ControllerList *list = this;
+            while (list->childLists[index] != nullptr)
             {
-                list = dynamic_cast<ControllerList *>(currentController);
-                if (list != nullptr)
-                    currentController = list->getCurrentController();
-            } while (list != nullptr);
-
-            return currentController;
+                list = list->childLists[index];
+                list->_compile();
+                if (list->controllers.empty())
+                    return list;
+                index = list->controllerIndex % list->controllers.size();
+            }
+            return list->controllers[index];
         }
 
         /**
@@ -126,6 +106,10 @@ namespace devils
          */
         void skip()
         {
+            // Get the speed to hand off
+            AutoController *prevController = getCurrentController();
+            double exitSpeed = prevController != nullptr ? prevController->getState().exitSpeed : 0;
+
             // Increment the controller index
             controllerIndex++;
 
@@ -136,11 +120,68 @@ namespace devils
             // Reset the next controller
             AutoController *currentController = getCurrentController();
             if (currentController != nullptr)
+            {
                 currentController->reset();
+                currentController->setEntrySpeed(exitSpeed);
+            }
+            currentState.exitSpeed = exitSpeed;
+            _syncState();
+        }
+
+        void setEntrySpeed(double speed) override
+        {
+            AutoController::setEntrySpeed(speed);
+            AutoController *currentController = getCurrentController();
+            if (currentController != nullptr)
+                currentController->setEntrySpeed(speed);
+        }
+
+        /**
+         * Finds which children are nested `ControllerList`s.
+         * Runs once on first use rather than in the constructor, since subclasses
+         * pass pointers to members that are not constructed until after the base class.
+         */
+        void _compile()
+        {
+            if (isCompiled)
+                return;
+            isCompiled = true;
+
+            childLists.clear();
+            for (AutoController *controller : controllers)
+                childLists.push_back(dynamic_cast<ControllerList *>(controller));
+        }
+
+        /**
+         * Copies the state of the current controller into the state of the list.
+         * Keeps the state of the last controller once the list is finished.
+         */
+        void _syncState()
+        {
+            if (getFinished())
+                return;
+
+            AutoController *controller = getCurrentController();
+            if (controller != nullptr)
+            {
+                AutoState &currentControllerState = controller->getState();
+                currentState.target = currentControllerState.target;
+                currentState.events = currentControllerState.events;
+                currentState.debugText = currentControllerState.debugText;
+            }
+            else
+            {
+                currentState.target = nullptr;
+                currentState.events = &NO_EVENTS;
+            }
         }
 
     private:
+        inline static ProfileSite updateProfile = ProfileSite("ControllerList.update");
+
         std::vector<AutoController *> controllers;
+        std::vector<ControllerList *> childLists; // nullptr for leaf controllers
+        bool isCompiled = false;
         bool loop = false;
         int controllerIndex = 0;
         int timeout = -1;
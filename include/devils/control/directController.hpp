@@ -5,6 +5,7 @@
 #include "../odom/odomSource.hpp"
 #include "../utils/logger.hpp"
 #include "../utils/pid.hpp"
+#include "../utils/tuningFile.hpp"
 #include "autoController.hpp"
 #include "../geometry/lerp.hpp"
 #include <cmath>
@@ -27,12 +28,29 @@ namespace devils
             : chassis(chassis),
               odometry(odometry)
         {
+            TuningFile::loadPID("Chassis.Translation", translationPID);
+
+            // The turn is scaled by distance, so the in-place `Chassis.Rotation` gains are scaled to match at
+            // `ROTATION_REFERENCE_DISTANCE`. Gains saved by hand under `DirectController.Rotation` take priority.
+            if (!TuningFile::loadPID("DirectController.Rotation", rotationPID))
+            {
+                PID chassisRotationPID = PID(0, 0, 0);
+                if (TuningFile::loadPID("Chassis.Rotation", chassisRotationPID))
+                {
+                    PIDGains gains = chassisRotationPID.getGains();
+                    rotationPID.setGains(PIDGains{gains.p / ROTATION_REFERENCE_DISTANCE,
+                                                  gains.i / ROTATION_REFERENCE_DISTANCE,
+                                                  gains.d / ROTATION_REFERENCE_DISTANCE});
+                }
+            }
         }
 
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+
             // Get Current Pose
-            Pose currentPose = odometry.getPose();
+            Pose currentPose = odometry.getSnapshot().getPose();
 
             // Calculate Forward & Turn
             double deltaX = targetPose->x - currentPose.x;
@@ -60,6 +78,10 @@ namespace devils
                 forward = std::clamp(forward, 0.0, 1.0);
             turn = std::clamp(turn * distanceToPose, -1.0, 1.0);
 
+            // Carry Speed From Previous Motion
+            forward = _applyEntrySpeed(forward);
+            currentState.exitSpeed = forward;
+
             // Drive
             chassis.move(forward, turn);
         }
@@ -92,6 +114,10 @@ namespace devils
         }
 
     private:
+        inline static ProfileSite updateProfile = ProfileSite("DirectController.update");
+
+        static constexpr double ROTATION_REFERENCE_DISTANCE = 16; // in
+
         PID translationPID = PID(0.18, 0, 0); // <-- Translation
         PID rotationPID = PID(0.05, 0, 0);    // <-- Rotation
 
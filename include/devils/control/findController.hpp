@@ -30,7 +30,7 @@ namespace devils
               chassis(chassis),
               odometry(odometry),
               occupancyGrid(occupancyGrid),
-              targetPose(odometry.getPose())
+              targetPose(odometry.getSnapshot().getPose())
         {
         }
 
@@ -43,6 +43,8 @@ namespace devils
 
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+
             controller.update();
         }
 
@@ -77,9 +79,10 @@ namespace devils
                 originalTargetPose = targetPose;
 
                 // Get Current Pose
-                Pose currentPose = odometry.getPose();
+                Pose currentPose = odometry.getSnapshot().getPose();
 
                 // Regenerate the path
+                ScopedTimer timer(replanProfile);
                 currentPath = PathFinder::generatePath(currentPose, targetPose, occupancyGrid);
 
                 // Update Pursuit Controller
@@ -95,6 +98,9 @@ namespace devils
         }
 
     private:
+        inline static ProfileSite updateProfile = ProfileSite("FindController.update");
+        inline static ProfileSite replanProfile = ProfileSite("FindController.replan");
+
         static constexpr double REGENERATE_DISTANCE = 12.0; // in
 
         // Required Components
@@ -4,6 +4,7 @@
 #include "autoController.hpp"
 #include "pros/rtos.hpp"
 #include "../utils/pid.hpp"
+#include "../utils/tuningFile.hpp"
 #include "../geometry/lerp.hpp"
 #include "../odom/odomSource.hpp"
 
@@ -25,6 +26,8 @@ namespace devils
         LinearController(BaseChassis &chassis, OdomSource &odometry, GeneratedPath &generatedPath)
             : chassis(chassis), odometry(odometry), generatedPath(generatedPath)
         {
+            TuningFile::loadPID("Chassis.Translation", translationPID);
+            TuningFile::loadPID("Chassis.Rotation", rotationPID);
         }
 
         /**
@@ -39,12 +42,14 @@ namespace devils
 
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+
             // Reset if not already
             if (lastCheckpointTime < 0)
                 reset();
 
             // Get Current Pose
-            Pose currentPose = odometry.getPose();
+            Pose currentPose = odometry.getSnapshot().getPose();
 
             // Calculate time since last checkpoint
             double timeSinceLastCheckpoint = pros::millis() - lastCheckpointTime;
@@ -129,6 +134,8 @@ namespace devils
         }
 
     private:
+        inline static ProfileSite updateProfile = ProfileSite("LinearController.update");
+
         // Constants
         static constexpr double DEFAULT_MAX_SPEED = 0.45;
         static constexpr double CHECKPOINT_TIMEOUT = 3000;       // ms
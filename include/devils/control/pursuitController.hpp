@@ -6,9 +6,15 @@
 #include "../utils/logger.hpp"
 #include "../utils/pid.hpp"
 #include "../geometry/lerp.hpp"
+#include "../path/occupancyGrid.hpp"
+#include "../path/pathFinder.hpp"
 #include "autoController.hpp"
 #include "directController.hpp"
+#include "pros/rtos.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <map>
 #include <vector>
 
 namespace devils
@@ -19,6 +25,17 @@ namespace devils
     class PursuitController : public AutoController
     {
     public:
+        /**
+         * Represents how early an event should trigger before its control point.
+         */
+        struct EventLead
+        {
+            /// @brief The distance before the control point to trigger the event in inches.
+            double distance = 0;
+            /// @brief The time before the control point to trigger the event in milliseconds. Converted to distance using the current speed.
+            double time = 0;
+        };
+
         /**
          * Constructs a new PursuitController.
          * @param chassis The chassis to control.
@@ -42,10 +59,24 @@ namespace devils
             directController.reset();
             lookaheadPointIndex = 0;
             controlPointIndex = 0;
+            closestPointIndex = 0;
+            progressDistance = 0;
+            progressSpeed = 0;
+            lastProgressTime = -1;
+            eventPointIndex = -1;
+            leadEvents.clear();
+            activeEvents.clear();
+            crossTrackError = 0;
+            isRecovering = false;
+            isReplanRequested = false;
+            isReplanning = false;
+            lastReplanTime = -1;
         }
 
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+
             // Abort if path is missing
             if (currentPath == nullptr || pathPoints == nullptr || controlPoints == nullptr)
                 return;
@@ -54,7 +85,31 @@ namespace devils
                 return;
 
             // Get Current Pose
-            Pose currentPose = odometry.getPose();
+            Pose currentPose = odometry.getSnapshot().getPose();
+
+            // Update Progress
+            // Progress is frozen while off the main path, and picks up again at the rejoin point
+            if (!isRecovering && !isReplanning)
+            {
+                _updateProgress(currentPose);
+                _checkCrossTrack(currentPose);
+            }
+
+            // Recover Back To Path
+            // Hold still while a recovery path is planned in the background
+            if (isReplanning && !_finishReplan())
+            {
+                chassis.stop();
+                currentState.target = nullptr;
+                currentState.debugText = "Replanning";
+                currentState.exitSpeed = 0;
+                return;
+            }
+            if (isRecovering)
+            {
+                _updateRecovery(currentPose);
+                return;
+            }
 
             // Update Control Point Index
             ControlPoint *prevControlPoint = &controlPoints->at(controlPointIndex);
@@ -92,6 +147,7 @@ namespace devils
                     currentState.isFinished = true;
                     currentState.events = &controlPoints->back().events;
                     currentState.debugText = "Finished Path " + std::to_string(currentState.events->size());
+                    currentState.exitSpeed = 0;
 
                     // Stop Chassis
                     chassis.stop();
@@ -100,8 +156,9 @@ namespace devils
             }
 
             // Update State
+            _updateEvents();
             currentState.target = targetPose;
-            currentState.events = &prevControlPoint->events;
+            currentState.events = &activeEvents;
             currentState.debugText = "I=" + std::to_string(lookaheadPointIndex) + ", R=" + std::to_string(prevControlPoint->isReversed);
             Logger::debug(currentState.debugText);
 
@@ -115,6 +172,13 @@ namespace devils
             directController.setTargetPose(*targetPose);
             directController.setReverse(prevControlPoint->isReversed);
             directController.update();
+            currentState.exitSpeed = directController.getState().exitSpeed;
+        }
+
+        void setEntrySpeed(double speed) override
+        {
+            AutoController::setEntrySpeed(speed);
+            directController.setEntrySpeed(speed);
         }
 
         /**
@@ -128,6 +192,8 @@ namespace devils
             {
                 controlPoints = &currentPath->controlPoints;
                 pathPoints = &currentPath->pathPoints;
+                if (currentPath->pathDistances.size() != pathPoints->size())
+                    currentPath->calculateDistances();
             }
             reset();
         }
@@ -141,8 +207,316 @@ namespace devils
             lookaheadDistance = distance;
         }
 
+        /**
+         * Triggers all events with the given name early, before the robot reaches their control point.
+         * Events without a lead trigger once the robot is within the lookahead distance of their control point.
+         * @param name The name of the event (e.g. `fire`)
+         * @param leadDistance The distance before the control point to trigger the event, in inches.
+         * @param leadTime The time before the control point to trigger the event, in milliseconds.
+         */
+        void setEventLead(std::string name, double leadDistance, double leadTime = 0)
+        {
+            eventLeads[name] = EventLead{leadDistance, leadTime};
+        }
+
+        /**
+         * Gets the distance the robot has travelled along the path.
+         * @return The distance along the path in inches.
+         */
+        double getProgressDistance()
+        {
+            return progressDistance;
+        }
+
+        /**
+         * Replans back onto the path around obstacles when the robot is pushed too far off of it.
+         * @param occupancyGrid The occupancy grid to plan around. An empty grid disables recovery.
+         * @param maxCrossTrackError The distance from the path that triggers a replan, in inches.
+         */
+        void useOccupancyGrid(OccupancyGrid &occupancyGrid, double maxCrossTrackError = DEFAULT_MAX_CROSS_TRACK_ERROR)
+        {
+            // An empty grid, such as from a missing file, has nothing to plan around
+            if (occupancyGrid.width <= 0 || occupancyGrid.height <= 0)
+            {
+                Logger::warn("PursuitController: Occupancy grid is empty, recovery is disabled");
+                this->occupancyGrid = nullptr;
+                return;
+            }
+            this->occupancyGrid = &occupancyGrid;
+            this->maxCrossTrackError = maxCrossTrackError;
+        }
+
+        /**
+         * Gets the distance from the robot to the nearest segment of the path.
+         * @return The cross-track error in inches.
+         */
+        double getCrossTrackError()
+        {
+            return crossTrackError;
+        }
+
+        /**
+         * Replans back onto the path on the next update, even if the robot is still close to it.
+         * Used after an impact, when the robot may be blocked or knocked off its heading.
+         * Does nothing without an occupancy grid, or while already planning or following a recovery path.
+         */
+        void replan()
+        {
+            if (isRecovering || isReplanning)
+                return;
+            isReplanRequested = true;
+        }
+
+        /**
+         * Checks if the robot is following a replanned path back onto the main path.
+         * @return True if the robot is recovering, false otherwise.
+         */
+        bool getRecovering()
+        {
+            return isRecovering;
+        }
+
+        /**
+         * Updates the closest path point and the speed of the robot along the path.
+         * Only searches a short window ahead of the last closest point, so progress never moves backwards.
+         * Costs O(`CLOSEST_POINT_WINDOW`) per update, however long the path is.
+         * @param currentPose The current pose of the robot.
+         */
+        void _updateProgress(Pose &currentPose)
+        {
+            // Find Closest Point
+            int searchEnd = std::min(closestPointIndex + CLOSEST_POINT_WINDOW, (int)pathPoints->size());
+            double closestDistance = pathPoints->at(closestPointIndex).distanceTo(currentPose);
+            for (int i = closestPointIndex + 1; i < searchEnd; i++)
+            {
+                double distance = pathPoints->at(i).distanceTo(currentPose);
+                if (distance < closestDistance)
+                {
+                    closestDistance = distance;
+                    closestPointIndex = i;
+                }
+            }
+
+            // Update Speed
+            double newProgressDistance = currentPath->pathDistances[closestPointIndex];
+            uint32_t now = pros::millis();
+            if (lastProgressTime >= 0 && now > lastProgressTime)
+            {
+                double speed = (newProgressDistance - progressDistance) * 1000.0 / (now - lastProgressTime);
+                progressSpeed += (speed - progressSpeed) * SPEED_FILTER_GAIN;
+            }
+            progressDistance = newProgressDistance;
+            lastProgressTime = now;
+
+            // Cross-Track Error
+            // The closest path point has already been found, so only its two neighboring segments need checking
+            crossTrackError = closestDistance;
+            if (closestPointIndex > 0)
+                crossTrackError = std::min(crossTrackError, _getSegmentDistance(currentPose, pathPoints->at(closestPointIndex - 1), pathPoints->at(closestPointIndex)));
+            if (closestPointIndex < pathPoints->size() - 1)
+                crossTrackError = std::min(crossTrackError, _getSegmentDistance(currentPose, pathPoints->at(closestPointIndex), pathPoints->at(closestPointIndex + 1)));
+        }
+
+        /**
+         * Gets the distance from a pose to a line segment.
+         * @param pose The pose to measure from.
+         * @param start The start of the segment.
+         * @param end The end of the segment.
+         * @return The distance to the closest point on the segment in inches.
+         */
+        static double _getSegmentDistance(Pose &pose, Pose &start, Pose &end)
+        {
+            double segmentX = end.x - start.x;
+            double segmentY = end.y - start.y;
+            double lengthSquared = segmentX * segmentX + segmentY * segmentY;
+            if (lengthSquared <= 0)
+                return pose.distanceTo(start);
+
+            double t = ((pose.x - start.x) * segmentX + (pose.y - start.y) * segmentY) / lengthSquared;
+            t = std::clamp(t, 0.0, 1.0);
+            return std::hypot(pose.x - (start.x + t * segmentX), pose.y - (start.y + t * segmentY));
+        }
+
+        /**
+         * Checks the cross-track error and starts planning a path back onto the main path if it is too large.
+         * Planning runs on its own task, since a search can take far longer than a control tick.
+         * @param currentPose The current pose of the robot.
+         * @return True if planning was started, false otherwise.
+         */
+        bool _checkCrossTrack(Pose &currentPose)
+        {
+            bool isRequested = isReplanRequested;
+            isReplanRequested = false;
+            if (occupancyGrid == nullptr || (!isRequested && crossTrackError < maxCrossTrackError))
+                return false;
+
+            // A search from before a reset may still be running
+            if (isReplanRunning)
+                return false;
+
+            // Don't retry a failed replan every tick
+            uint32_t now = pros::millis();
+            if (!isRequested && lastReplanTime >= 0 && now - lastReplanTime < REPLAN_RETRY_TIME)
+                return false;
+            lastReplanTime = now;
+
+            // Rejoin one lookahead ahead, but never past the next control point so its events still trigger
+            int rejoinIndex = closestPointIndex;
+            while (rejoinIndex < pathPoints->size() - 1 && currentPath->pathDistances[rejoinIndex] < progressDistance + lookaheadDistance)
+                rejoinIndex++;
+            int nextControlPointIndex = std::max(eventPointIndex, 0) + 1;
+            if (nextControlPointIndex < controlPoints->size())
+                rejoinIndex = std::max(closestPointIndex, std::min(rejoinIndex, currentPath->controlPointIndices[nextControlPointIndex]));
+
+            // Replan
+            if (isRequested)
+                Logger::warn("PursuitController: Replan requested");
+            else
+                Logger::warn("PursuitController: Off path by " + std::to_string(crossTrackError) + "in, replanning");
+            Pose startPose = currentPose;
+            Pose rejoinPose = pathPoints->at(rejoinIndex);
+            OccupancyGrid *grid = occupancyGrid;
+            pendingRejoinPointIndex = rejoinIndex;
+            isReplanning = true;
+            isReplanRunning = true;
+            pros::Task([this, startPose, rejoinPose, grid]()
+                       {
+                           ScopedTimer timer(replanProfile);
+                           pendingRecoveryPath = PathFinder::generatePath(startPose, rejoinPose, *grid);
+                           isReplanRunning = false; });
+            return true;
+        }
+
+        /**
+         * Picks up the recovery path once the planning task has finished.
+         * @return True if planning has finished, false if it is still running.
+         */
+        bool _finishReplan()
+        {
+            if (isReplanRunning)
+                return false;
+            isReplanning = false;
+
+            recoveryPath = pendingRecoveryPath;
+            if (!recoveryPath.isGenerated())
+                return true;
+
+            rejoinPointIndex = pendingRejoinPointIndex;
+            recoveryPointIndex = 0;
+            isRecovering = true;
+            isReplanRequested = false;
+            return true;
+        }
+
+        /**
+         * Follows the recovery path, then resumes the main path at the rejoin point.
+         * Active events are left unchanged while recovering.
+         * @param currentPose The current pose of the robot.
+         */
+        void _updateRecovery(Pose &currentPose)
+        {
+            // Update Lookahead Point
+            PoseSequence &recoveryPoints = recoveryPath.pathPoints;
+            while (recoveryPointIndex < recoveryPoints.size() - 1 &&
+                   recoveryPoints[recoveryPointIndex].distanceTo(currentPose) < lookaheadDistance)
+                recoveryPointIndex++;
+
+            // Rejoin Main Path
+            Pose &rejoinPose = pathPoints->at(rejoinPointIndex);
+            if (rejoinPose.distanceTo(currentPose) < lookaheadDistance)
+            {
+                isRecovering = false;
+                closestPointIndex = rejoinPointIndex;
+                lookaheadPointIndex = rejoinPointIndex;
+                progressDistance = currentPath->pathDistances[rejoinPointIndex];
+                lastProgressTime = -1;
+                while (controlPointIndex < controlPoints->size() - 2 &&
+                       currentPath->controlPointIndices[controlPointIndex + 1] <= rejoinPointIndex)
+                    controlPointIndex++;
+                return;
+            }
+
+            // Drive To Point
+            currentState.target = &recoveryPoints[recoveryPointIndex];
+            currentState.debugText = "Recovering " + std::to_string(recoveryPointIndex) + "/" + std::to_string(recoveryPoints.size());
+            directController.setTargetPose(recoveryPoints[recoveryPointIndex]);
+            directController.setReverse(false);
+            directController.update();
+            currentState.exitSpeed = directController.getState().exitSpeed;
+        }
+
+        /**
+         * Gets the distance before its control point that an event should trigger.
+         * @param event The event to check.
+         * @return The lead distance in inches.
+         */
+        double _getEventLead(PathEvent &event)
+        {
+            auto lead = eventLeads.find(event.name);
+            if (lead == eventLeads.end())
+                return lookaheadDistance;
+            return lead->second.distance + lead->second.time * progressSpeed / 1000.0;
+        }
+
+        /**
+         * Updates the active events from the distance along the path.
+         * The active events are only rebuilt when an event is triggered or the current control point changes.
+         */
+        void _updateEvents()
+        {
+            bool isChanged = false;
+
+            // Current Control Point
+            int newEventPointIndex = std::max(eventPointIndex, 0);
+            while (newEventPointIndex < controlPoints->size() - 1 &&
+                   progressDistance >= currentPath->getControlPointDistance(newEventPointIndex + 1) - lookaheadDistance)
+                newEventPointIndex++;
+            if (newEventPointIndex != eventPointIndex)
+            {
+                eventPointIndex = newEventPointIndex;
+                leadEvents.clear();
+                isChanged = true;
+            }
+
+            // Leading Events
+            if (!eventLeads.empty())
+            {
+                for (int i = eventPointIndex + 1; i < controlPoints->size(); i++)
+                {
+                    double controlPointDistance = currentPath->getControlPointDistance(i);
+                    if (controlPointDistance - progressDistance > MAX_LEAD_DISTANCE)
+                        break;
+
+                    for (PathEvent &event : controlPoints->at(i).events)
+                    {
+                        if (progressDistance < controlPointDistance - _getEventLead(event))
+                            continue;
+                        if (std::find(leadEvents.begin(), leadEvents.end(), &event) != leadEvents.end())
+                            continue;
+                        leadEvents.push_back(&event);
+                        isChanged = true;
+                    }
+                }
+            }
+
+            // Rebuild Active Events
+            if (!isChanged)
+                return;
+            activeEvents = controlPoints->at(eventPointIndex).events;
+            for (PathEvent *event : leadEvents)
+                activeEvents.push_back(*event);
+        }
+
     private:
-        static constexpr double DEFAULT_LOOKAHEAD_DISTANCE = 8.0; // in
+        inline static ProfileSite updateProfile = ProfileSite("PursuitController.update");
+        inline static ProfileSite replanProfile = ProfileSite("PursuitController.replan");
+
+        static constexpr double DEFAULT_LOOKAHEAD_DISTANCE = 8.0;     // in
+        static constexpr double MAX_LEAD_DISTANCE = 48.0;             // in
+        static constexpr double SPEED_FILTER_GAIN = 0.2;              // %
+        static constexpr int CLOSEST_POINT_WINDOW = 40;               // path points
+        static constexpr double DEFAULT_MAX_CROSS_TRACK_ERROR = 12.0; // in
+        static constexpr uint32_t REPLAN_RETRY_TIME = 500;            // ms
 
         // Object Handles
         BaseChassis &chassis;
@@ -159,5 +533,33 @@ namespace devils
         int controlPointIndex = 0;                             // Current control index of the event
         bool skipCheckpoints = false;                          // Whether the controller can skip checkpoints
         double lookaheadDistance = DEFAULT_LOOKAHEAD_DISTANCE; // in
+
+        // Event State
+        std::map<std::string, EventLead> eventLeads;
+        std::vector<PathEvent *> leadEvents; // Events triggered early from upcoming control points
+        PathEvents activeEvents;
+        int eventPointIndex = -1;      // Control point whose events are active
+        int closestPointIndex = 0;     // Closest path index to the robot
+        double progressDistance = 0;   // in
+        double progressSpeed = 0;      // in/s
+        int64_t lastProgressTime = -1; // ms
+
+        // Recovery State
+        OccupancyGrid *occupancyGrid = nullptr;
+        GeneratedPath recoveryPath;
+        double maxCrossTrackError = DEFAULT_MAX_CROSS_TRACK_ERROR; // in
+        double crossTrackError = 0;                                // in
+        bool isRecovering = false;
+        bool isReplanRequested = false;
+        bool isReplanning = false; // Waiting on the planning task
+
+        // Planning Task
+        // `pendingRecoveryPath` is only written by the task while `isReplanRunning` is true
+        GeneratedPath pendingRecoveryPath;
+        int pendingRejoinPointIndex = 0;
+        std::atomic<bool> isReplanRunning = false;
+        int rejoinPointIndex = 0;    // Main path index to resume from
+        int recoveryPointIndex = 0;  // Recovery path index of the lookahead
+        int64_t lastReplanTime = -1; // ms
     };
 }
\ No newline at end of file
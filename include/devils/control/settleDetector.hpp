@@ -0,0 +1,148 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include <cmath>
+
+namespace devils
+{
+    /**
+     * Detects when a motion has settled on its target.
+     * A motion is settled once its error and velocity have both stayed within their thresholds for a period of time,
+     * or is given up on once it times out.
+     */
+    class SettleDetector
+    {
+    public:
+        /**
+         * Creates a new settle detector.
+         * @param errorThreshold The maximum absolute error to be considered settled.
+         * @param velocityThreshold The maximum absolute velocity to be considered settled, in error units per second.
+         * @param settleTime The time the error and velocity must stay within their thresholds in milliseconds.
+         * @param timeout The maximum time before giving up in milliseconds, or -1 to disable.
+         */
+        SettleDetector(double errorThreshold, double velocityThreshold, double settleTime, double timeout = -1)
+            : errorThreshold(errorThreshold),
+              velocityThreshold(velocityThreshold),
+              settleTime(settleTime),
+              timeout(timeout)
+        {
+        }
+
+        /**
+         * Resets the detector. Should be called when the motion starts.
+         */
+        void reset()
+        {
+            startTime = -1;
+            bandStartTime = -1;
+            lastTime = -1;
+            lastError = NAN;
+            isSettled = false;
+            isTimedOut = false;
+        }
+
+        /**
+         * Updates the detector, estimating the velocity from the change in error.
+         * @param error The current error of the motion. Non-finite values are treated as outside the threshold.
+         * @return True if the motion has settled or timed out, false otherwise.
+         */
+        bool update(double error)
+        {
+            uint32_t now = pros::millis();
+            double velocity = INFINITY;
+            if (lastTime >= 0 && now > lastTime && std::isfinite(error) && std::isfinite(lastError))
+                velocity = (error - lastError) * 1000.0 / (now - lastTime);
+            lastError = error;
+            lastTime = now;
+
+            return update(error, velocity);
+        }
+
+        /**
+         * Updates the detector with a measured velocity.
+         * @param error The current error of the motion.
+         * @param velocity The current velocity of the motion, in error units per second.
+         * @return True if the motion has settled or timed out, false otherwise.
+         */
+        bool update(double error, double velocity)
+        {
+            uint32_t now = pros::millis();
+            if (startTime < 0)
+                startTime = now;
+
+            // Time In Band
+            bool isInBand = std::abs(error) <= errorThreshold && std::abs(velocity) <= velocityThreshold;
+            if (!isInBand)
+                bandStartTime = -1;
+            else if (bandStartTime < 0)
+                bandStartTime = now;
+
+            isSettled = bandStartTime >= 0 && now - bandStartTime >= settleTime;
+            isTimedOut = timeout > 0 && now - startTime >= timeout;
+            return isDone();
+        }
+
+        /**
+         * Sets the thresholds of the detector.
+         * @param errorThreshold The maximum absolute error to be considered settled.
+         * @param velocityThreshold The maximum absolute velocity to be considered settled, in error units per second.
+         * @param settleTime The time the error and velocity must stay within their thresholds in milliseconds.
+         */
+        void setThresholds(double errorThreshold, double velocityThreshold, double settleTime)
+        {
+            this->errorThreshold = errorThreshold;
+            this->velocityThreshold = velocityThreshold;
+            this->settleTime = settleTime;
+        }
+
+        /**
+         * Sets the maximum time before giving up.
+         * @param timeout The timeout in milliseconds, or -1 to disable.
+         */
+        void setTimeout(double timeout)
+        {
+            this->timeout = timeout;
+        }
+
+        /**
+         * Checks if the motion has settled or timed out.
+         * @return True if the motion has settled or timed out, false otherwise.
+         */
+        bool isDone()
+        {
+            return isSettled || isTimedOut;
+        }
+
+        /**
+         * Checks if the motion has settled.
+         * @return True if the motion has settled, false otherwise.
+         */
+        bool getSettled()
+        {
+            return isSettled;
+        }
+
+        /**
+         * Checks if the motion has timed out.
+         * @return True if the motion timed out before settling, false otherwise.
+         */
+        bool getTimedOut()
+        {
+            return isTimedOut;
+        }
+
+    private:
+        // Thresholds
+        double errorThreshold;
+        double velocityThreshold; // units/s
+        double settleTime;        // ms
+        double timeout;           // ms
+
+        // State
+        int64_t startTime = -1;     // ms
+        int64_t bandStartTime = -1; // ms
+        int64_t lastTime = -1;      // ms
+        double lastError = NAN;
+        bool isSettled = false;
+        bool isTimedOut = false;
+    };
+}
@@ -49,6 +49,8 @@ namespace devils
 
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+
             // Check if not already reset
             if (startTime < 0)
                 reset();
@@ -86,6 +88,8 @@ namespace devils
         }
 
     private:
+        inline static ProfileSite updateProfile = ProfileSite("TimeController.update");
+
         // Input Values
         BaseChassis &chassis;
         int duration;
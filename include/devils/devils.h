@@ -12,10 +12,29 @@
 #include "control/linearController.hpp"
 #include "control/findController.hpp"
 #include "control/directController.hpp"
+#include "control/boomerangController.hpp"
 #include "control/timeController.hpp"
 #include "control/chaseController.hpp"
 #include "control/collectionController.hpp"
 #include "control/controllerList.hpp"
+#include "control/settleDetector.hpp"
+
+// Command
+#include "command/subsystem.hpp"
+#include "command/command.hpp"
+#include "command/commandGroups.hpp"
+#include "command/basicCommands.hpp"
+#include "command/commandScheduler.hpp"
+
+// Routine
+#include "routine/awaitable.hpp"
+#include "routine/routine.hpp"
+#include "routine/routineRunner.hpp"
+
+// Script
+#include "script/scriptProgram.hpp"
+#include "script/scriptCompiler.hpp"
+#include "script/scriptVM.hpp"
 
 // Chassis
 #include "chassis/chassis.hpp"
@@ -38,17 +57,27 @@
 #include "display/poseRenderer.hpp"
 
 // Hardware
+#include "hardware/battery.hpp"
 #include "hardware/gps.hpp"
 #include "hardware/imu.hpp"
 #include "hardware/opticalSensor.hpp"
+#include "hardware/distanceSensor.hpp"
 #include "hardware/visionSensor.hpp"
 #include "hardware/scuffPneumatic.hpp"
 #include "hardware/scuffPneumaticGroup.hpp"
 
 // Odom
 #include "odom/odomSource.hpp"
+#include "odom/poseHistory.hpp"
+#include "odom/slipDetector.hpp"
 #include "odom/complementaryFilterOdom.hpp"
+#include "odom/extendedKalmanFilterOdom.hpp"
+#include "odom/particleFilter.hpp"
+#include "odom/monteCarloOdom.hpp"
+#include "odom/odomRecorder.hpp"
+#include "odom/unscentedKalmanFilterOdom.hpp"
 #include "odom/trackingWheelOdom.hpp"
+#include "odom/threeWheelOdom.hpp"
 #include "odom/differentialWheelOdom.hpp"
 #include "odom/transformOdom.hpp"
 
@@ -57,6 +86,7 @@
 #include "path/pathFinder.hpp"
 #include "path/occupancyGrid.hpp"
 #include "path/occupancyFileReader.hpp"
+#include "path/eventRegistry.hpp"
 
 // Game Object
 #include "gameobject/gameObject.hpp"
@@ -75,3 +105,11 @@
 #include "utils/joystickCurve.hpp"
 #include "utils/pid.hpp"
 #include "utils/eventTimer.hpp"
+#include "utils/tuningFile.hpp"
+#include "utils/relayTuner.hpp"
+#include "utils/flywheelController.hpp"
+#include "utils/loopRate.hpp"
+#include "utils/scheduler.hpp"
+#include "utils/profiler.hpp"
+#include "utils/eventDispatcher.hpp"
+#include "utils/seqLock.hpp"
@@ -67,7 +67,7 @@ namespace devils
             }
 
             // Get Poses
-            Pose &currentPose = odomSource->getPose();
+            Pose currentPose = odomSource->getSnapshot().getPose();
             Pose *targetPose = controller->getState().target;
 
             // Abort if no point
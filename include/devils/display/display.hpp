@@ -1,6 +1,7 @@
 #pragma once
 #include "renderer.hpp"
 #include "../utils/runnable.hpp"
+#include "../utils/profiler.hpp"
 
 namespace devils
 {
@@ -42,6 +43,8 @@ namespace devils
          */
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+
             for (Renderer *renderer : renderers)
                 renderer->update();
 
@@ -78,6 +81,8 @@ namespace devils
         }
 
     private:
+        inline static ProfileSite updateProfile = ProfileSite("Display.update");
+
         lv_obj_t *rootObject;
         std::vector<Renderer *> renderers;
     };
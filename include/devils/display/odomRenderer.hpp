@@ -75,7 +75,7 @@ namespace devils
         void update() override
         {
             // Pose
-            Pose pose = odomSource->getPose();
+            Pose pose = odomSource->getSnapshot().getPose();
 
             // Object
             lv_obj_set_pos(
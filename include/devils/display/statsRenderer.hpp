@@ -2,9 +2,11 @@
 #include "../geometry/pose.hpp"
 #include "../odom/odomSource.hpp"
 #include "../../pros/misc.hpp"
+#include "../hardware/battery.hpp"
 #include "displayUtils.hpp"
 #include "renderer.hpp"
 #include <cmath>
+#include <cstdio>
 #include <string>
 
 namespace devils
@@ -46,6 +48,8 @@ namespace devils
         {
             // Get Stats
             double batteryPercent = pros::battery::get_capacity();
+            double batteryVoltage = Battery::getVoltage();
+            double batteryCompensation = Battery::getCompensation();
             bool isCompetition = pros::competition::is_connected();
             bool isAutonomous = pros::competition::is_autonomous();
             bool isDisabled = pros::competition::is_disabled();
@@ -54,6 +58,9 @@ namespace devils
             // Create Text
             std::stringstream stream;
             stream << "Battery: " << DisplayUtils::colorizeValue(batteryPercent / 100.0, std::to_string((int)batteryPercent) + "%") << "\n";
+            char voltageText[32];
+            snprintf(voltageText, sizeof(voltageText), "%.1fV (x%.2f)", batteryVoltage, batteryCompensation);
+            stream << "Voltage: " << voltageText << "\n";
             stream << "Competition: " << DisplayUtils::colorizeValue(isCompetition, isCompetition ? "Yes" : "No") << "\n";
             stream << "Mode: " << DisplayUtils::colorizeValue(!isAutonomous, isAutonomous ? "Auto" : "Driver") << "\n";
             stream << "Status: " << DisplayUtils::colorizeValue(!isDisabled, isDisabled ? "Disabled" : "Enabled") << "\n";
@@ -70,7 +77,7 @@ namespace devils
             // Odom
             if (odomSource != nullptr)
             {
-                auto pose = odomSource->getPose();
+                Pose pose = odomSource->getSnapshot().getPose();
                 stream << "\n";
                 stream << "X: " << (int)pose.x << " in\n";
                 stream << "Y: " << (int)pose.y << " in\n";
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <cmath>
+#include <vector>
 #include "vector2.hpp"
 
 namespace devils
@@ -123,6 +124,31 @@ namespace devils
             return {x / mag, y / mag, rotation};
         }
 
+        /**
+         * Moves the pose along a constant-curvature arc (the SE(2) exponential).
+         * Exact for any step length as long as the robot turned at a constant rate,
+         * unlike stepping along a single heading.
+         * @param forward The distance travelled along the robot's heading in inches
+         * @param lateral The distance travelled to the right of the robot's heading in inches,
+         *                the side that positive rotation turns toward
+         * @param deltaRotation The change in rotation over the arc in radians
+         * @return The pose at the end of the arc
+         */
+        Pose integrateArc(double forward, double lateral, double deltaRotation)
+        {
+            // The chord of an arc points along the average heading and is shorter than the arc
+            double halfRotation = deltaRotation / 2;
+            double chordScale = std::abs(halfRotation) < 1e-6
+                                    ? 1 - halfRotation * halfRotation / 6
+                                    : std::sin(halfRotation) / halfRotation;
+
+            double cosHeading = std::cos(rotation + halfRotation);
+            double sinHeading = std::sin(rotation + halfRotation);
+            return {x + (forward * cosHeading - lateral * sinHeading) * chordScale,
+                    y + (forward * sinHeading + lateral * cosHeading) * chordScale,
+                    rotation + deltaRotation};
+        }
+
         /**
          * Prints the pose to a string
          * @return The pose as a string
@@ -1,5 +1,6 @@
 #pragma once
 #include <cmath>
+#include <sstream>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -0,0 +1,104 @@
+#pragma once
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+#include "../utils/logger.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace devils
+{
+    /**
+     * Scales motor voltages up as the battery drains below a nominal voltage, so commands behave the same on a full or drained battery.
+     * The battery is sampled at most every `SAMPLE_PERIOD` and low-pass filtered, so calling this from every motor command is cheap.
+     * Safe to call from any task. Only one task samples the battery each period.
+     */
+    struct Battery
+    {
+        /**
+         * Gets the filtered battery voltage.
+         * @return The battery voltage in volts.
+         */
+        static double getVoltage()
+        {
+            _sample();
+            return filteredVoltage;
+        }
+
+        /**
+         * Gets the factor that motor voltages are multiplied by.
+         * @return The compensation factor. 1 at or above the nominal voltage, higher as the battery drains.
+         */
+        static double getCompensation()
+        {
+            if (!isEnabled)
+                return 1;
+            _sample();
+            return compensation;
+        }
+
+        /**
+         * Scales a motor voltage to the nominal battery voltage.
+         * Saturates at full voltage, which is the best the motor can do on a drained battery.
+         * @param voltage The voltage to run the motor at, from -1 to 1.
+         * @return The compensated voltage, from -1 to 1.
+         */
+        static double compensate(double voltage)
+        {
+            return std::clamp(voltage * getCompensation(), -1.0, 1.0);
+        }
+
+        /**
+         * Enables or disables voltage compensation.
+         * @param isEnabled Whether to scale motor voltages to the nominal voltage.
+         */
+        static void setEnabled(bool isEnabled)
+        {
+            Battery::isEnabled = isEnabled;
+        }
+
+        /**
+         * Samples the battery voltage if `SAMPLE_PERIOD` has passed since the last sample.
+         */
+        static void _sample()
+        {
+            // Claim the sample so only one task updates the filter
+            uint32_t now = pros::millis();
+            uint32_t lastTime = lastSampleTime;
+            if (lastTime != 0 && now - lastTime < SAMPLE_PERIOD)
+                return;
+            if (!lastSampleTime.compare_exchange_strong(lastTime, now))
+                return;
+
+            // Read Voltage
+            int32_t millivolts = pros::battery::get_voltage();
+            if (millivolts == PROS_ERR || millivolts <= 0)
+            {
+                Logger::warn("Battery: failed to read voltage");
+                return;
+            }
+            double voltage = millivolts / 1000.0;
+
+            // Filter
+            double lastVoltage = filteredVoltage;
+            double newVoltage = lastVoltage <= 0 ? voltage : lastVoltage + (voltage - lastVoltage) * FILTER_GAIN;
+            filteredVoltage = newVoltage;
+
+            // Only boost below the nominal voltage, a full battery runs at the commanded voltage
+            compensation = std::clamp(NOMINAL_VOLTAGE / newVoltage, MIN_COMPENSATION, MAX_COMPENSATION);
+        }
+
+    private:
+        Battery() = delete;
+
+        static constexpr double NOMINAL_VOLTAGE = 12.0; // V
+        static constexpr uint32_t SAMPLE_PERIOD = 100;  // ms
+        static constexpr double FILTER_GAIN = 0.1;      // %
+        static constexpr double MIN_COMPENSATION = 1.0;
+        static constexpr double MAX_COMPENSATION = 1.3;
+
+        inline static std::atomic<bool> isEnabled = true;
+        inline static std::atomic<uint32_t> lastSampleTime = 0;
+        inline static std::atomic<double> filteredVoltage = 0; // V
+        inline static std::atomic<double> compensation = 1;
+    };
+}
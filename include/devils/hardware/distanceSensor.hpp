@@ -0,0 +1,64 @@
+#pragma once
+#include "pros/distance.hpp"
+#include "pros/error.h"
+#include "../utils/logger.hpp"
+#include "../geometry/units.hpp"
+#include <string>
+
+namespace devils
+{
+    /**
+     * Represents a V5 distance sensor.
+     */
+    class DistanceSensor
+    {
+    public:
+        /**
+         * Creates a new distance sensor.
+         * @param name The name of the distance sensor (for logging purposes)
+         * @param port The port of the distance sensor (from 1 to 21)
+         */
+        DistanceSensor(std::string name, uint8_t port)
+            : name(name),
+              sensor(port)
+        {
+            if (errno != 0 && LOGGING_ENABLED)
+                Logger::error(name + ": distance sensor port is invalid");
+        }
+
+        /**
+         * Gets the distance to the object in front of the sensor in inches.
+         * @return The distance in inches or `PROS_ERR_F` if the operation failed or nothing is in range.
+         */
+        double getDistance()
+        {
+            std::int32_t distance = sensor.get();
+            if (distance == PROS_ERR && LOGGING_ENABLED)
+                Logger::error(name + ": distance sensor get distance failed");
+            if (distance == PROS_ERR || distance >= NO_OBJECT_DISTANCE)
+                return PROS_ERR_F;
+            return Units::metersToIn(distance / 1000.0);
+        }
+
+        /**
+         * Gets the confidence of the distance reading.
+         * Only reported for objects further than about 200mm.
+         * @return The confidence from 0 to 1 where 1 is the most confident, or 0 if the operation failed.
+         */
+        double getConfidence()
+        {
+            std::int32_t confidence = sensor.get_confidence();
+            if (confidence == PROS_ERR && LOGGING_ENABLED)
+                Logger::error(name + ": distance sensor get confidence failed");
+            return confidence == PROS_ERR ? 0.0 : confidence / MAX_CONFIDENCE;
+        }
+
+    private:
+        static constexpr bool LOGGING_ENABLED = true;
+        static constexpr std::int32_t NO_OBJECT_DISTANCE = 9999; // mm
+        static constexpr double MAX_CONFIDENCE = 63.0;
+
+        std::string name;
+        pros::Distance sensor;
+    };
+}
\ No newline at end of file
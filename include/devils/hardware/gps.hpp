@@ -1,10 +1,12 @@
 #pragma once
 #include "pros/gps.hpp"
 #include "../utils/logger.hpp"
+#include "../utils/profiler.hpp"
 #include "../geometry/pose.hpp"
 #include "../geometry/units.hpp"
 #include "../geometry/polygon.hpp"
 #include "../odom/odomSource.hpp"
+#include "../utils/seqLock.hpp"
 
 namespace devils
 {
@@ -34,11 +36,14 @@ namespace devils
          */
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+
             double gpsX = gps.get_x_position();
             double gpsY = gps.get_y_position();
             double gpsHeading = gps.get_heading();
+            double gpsError = gps.get_error();
 
-            if (gpsX == PROS_ERR_F || gpsY == PROS_ERR_F || gpsHeading == PROS_ERR_F)
+            if (gpsX == PROS_ERR_F || gpsY == PROS_ERR_F || gpsHeading == PROS_ERR_F || gpsError == PROS_ERR_F)
             {
                 Logger::error(name + ": GPS update failed");
                 return;
@@ -48,8 +53,10 @@ namespace devils
             gpsX = Units::metersToIn(gpsX);
             gpsY = -Units::metersToIn(gpsY);
             gpsHeading = Units::normalizeRadians(Units::degToRad(gpsHeading) - GPS_ROTATION_OFFSET - rotationalOffset);
+            gpsError = Units::metersToIn(gpsError);
 
-            // Check Calibrating
+            // Check Lock
+            _updateLock(gpsError);
             if (isCalibrating())
                 return;
 
@@ -61,17 +68,29 @@ namespace devils
             }
 
             // Update Pose
+            // Timestamped when the GPS measured it, so fusion can compare it to where the robot was at the time
             currentPose.x = gpsX;
             currentPose.y = gpsY;
             currentPose.rotation = gpsHeading;
+            snapshot.write(PoseSample{pros::millis() - latency, gpsX, gpsY, gpsHeading, 0, 0, 0, gpsError});
+        }
+
+        /**
+         * Gets the latest pose published by `GPS::update`.
+         * @return The latest pose of the robot.
+         */
+        PoseSample getSnapshot() override
+        {
+            return snapshot.read();
         }
 
         /**
-         * Restarts the calibration timer
+         * Drops the GPS lock, so readings are ignored until the GPS locks on again.
          */
         void reset()
         {
-            calibrationStartTime = -1;
+            isLocked = false;
+            lockCount = 0;
         }
 
         /**
@@ -124,26 +143,69 @@ namespace devils
         }
 
         /**
-         * Checks if the GPS is calibrating. GPS takes a few seconds to lock on to the field strip.
+         * Checks if the GPS is calibrating. GPS takes a few seconds to lock on to the field strip,
+         * and loses its lock when the field strip is blocked.
          * @return Whether the GPS is calibrating
          */
         bool isCalibrating()
         {
-            if (calibrationStartTime < 0)
-                calibrationStartTime = pros::millis();
-            return (pros::millis() - calibrationStartTime) < CALIBRATION_TIME;
+            return !isLocked;
+        }
+
+        /**
+         * Sets the delay between the GPS measuring its position and the reading arriving.
+         * Readings are timestamped this far in the past.
+         * @param latency The latency of the GPS in milliseconds
+         */
+        void setLatency(uint32_t latency)
+        {
+            this->latency = latency;
+        }
+
+        /**
+         * Updates the lock from the error reported by the GPS.
+         * The GPS locks once its error stays low for `LOCK_SAMPLES` readings in a row,
+         * and unlocks as soon as its error rises above `UNLOCK_ERROR`.
+         * @param error The error reported by the GPS in inches
+         */
+        void _updateLock(double error)
+        {
+            if (error > UNLOCK_ERROR)
+            {
+                if (isLocked)
+                    Logger::warn(name + ": GPS lost lock");
+                isLocked = false;
+                lockCount = 0;
+            }
+            else if (!isLocked && error <= LOCK_ERROR && ++lockCount >= LOCK_SAMPLES)
+            {
+                isLocked = true;
+                Logger::info(name + ": GPS locked");
+            }
+            else if (!isLocked && error > LOCK_ERROR)
+            {
+                lockCount = 0;
+            }
         }
 
     private:
-        static constexpr int CALIBRATION_TIME = 7000;             // ms
+        inline static ProfileSite updateProfile = ProfileSite("GPS.update");
+
         static constexpr double GPS_ROTATION_OFFSET = M_PI * 0.5; // PROS defaults to north as 0 degrees
+        static constexpr uint32_t DEFAULT_LATENCY = 30;           // ms
+        static constexpr double LOCK_ERROR = 1.0;                 // in
+        static constexpr double UNLOCK_ERROR = 4.0;               // in
+        static constexpr int LOCK_SAMPLES = 5;
         static constexpr double MAX_GPS_X = 72;
         static constexpr double MAX_GPS_Y = 72;
 
         std::string name;
         pros::Gps gps;
         Pose currentPose = Pose(0, 0, 0);
+        SeqLock<PoseSample> snapshot;
         double rotationalOffset = 0;
-        int calibrationStartTime = -1;
+        uint32_t latency = DEFAULT_LATENCY;
+        bool isLocked = false;
+        int lockCount = 0;
     };
 }
\ No newline at end of file
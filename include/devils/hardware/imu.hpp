@@ -35,15 +35,18 @@ namespace devils
         Vector3 getAccel()
         {
             auto accel = imu.get_accel();
-            if (accel.x == PROS_ERR_F && LOGGING_ENABLED)
+            if (accel.x == PROS_ERR_F)
             {
-                Logger::error(name + ": imu get accel failed");
+                if (LOGGING_ENABLED)
+                    Logger::error(name + ": imu get accel failed");
                 return Vector3(0, 0, 0);
             }
+
+            // PROS reports acceleration in Gs
             return Vector3(
-                Units::metersToIn(accel.x),
-                Units::metersToIn(accel.y),
-                Units::metersToIn(accel.z));
+                Units::metersToIn(accel.x * GRAVITY),
+                Units::metersToIn(accel.y * GRAVITY),
+                Units::metersToIn(accel.z * GRAVITY));
         }
 
         /**
@@ -58,6 +61,19 @@ namespace devils
             return heading == PROS_ERR_F ? PROS_ERR_F : Units::degToRad(heading);
         }
 
+        /**
+         * Gets the current yaw rate of the IMU in radians per second.
+         * Positive in the same direction that `getHeading` increases.
+         * @return The current yaw rate of the IMU in radians per second or `PROS_ERR_F` if the operation failed.
+         */
+        double getYawRate()
+        {
+            auto gyro = imu.get_gyro_rate();
+            if (gyro.z == PROS_ERR_F && LOGGING_ENABLED)
+                Logger::error(name + ": imu get gyro rate failed");
+            return gyro.z == PROS_ERR_F ? PROS_ERR_F : Units::degToRad(gyro.z);
+        }
+
         /**
          * Gets the current pitch of the IMU in radians.
          * @return The current pitch of the IMU in radians or `PROS_ERR_F` if the operation failed.
@@ -116,6 +132,7 @@ namespace devils
     private:
         static constexpr bool CALIBRATE_ON_START = false;
         static constexpr bool LOGGING_ENABLED = true;
+        static constexpr double GRAVITY = 9.80665; // m/s^2
 
         double headingOffset = 0;
 
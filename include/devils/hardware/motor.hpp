@@ -16,6 +16,19 @@ namespace devils
          */
         virtual void moveVoltage(double voltage) = 0;
 
+        /**
+         * Runs the motor in velocity mode using the motor's onboard velocity controller.
+         * @param velocity The velocity to run the motor at in RPM.
+         */
+        virtual void moveVelocity(double velocity) = 0;
+
+        /**
+         * Moves the motor to an absolute position using the motor's onboard position controller.
+         * @param position The position to move to in encoder ticks.
+         * @param maxVelocity The maximum velocity of the move in RPM.
+         */
+        virtual void movePosition(double position, double maxVelocity) = 0;
+
         /**
          * Stops the motor.
          */
@@ -26,5 +39,11 @@ namespace devils
          * @return The current position of the motor in encoder ticks.
          */
         virtual double getPosition() = 0;
+
+        /**
+         * Gets the current velocity of the motor in RPM.
+         * @return The current velocity of the motor in RPM.
+         */
+        virtual double getVelocity() = 0;
     };
 }
\ No newline at end of file
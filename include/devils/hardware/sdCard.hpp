@@ -42,5 +42,33 @@ namespace devils
             // Return Data
             return data;
         }
+
+        /**
+         * Writes a string to a raw file on the SD card, replacing the file if it exists.
+         * @param fileName The name of the file to write.
+         * @param data The raw data to write.
+         * @return True if the file was written, false otherwise.
+         */
+        static bool writeFromString(std::string fileName, std::string data)
+        {
+            if (!isInserted())
+            {
+                Logger::error("SDCard::writeFromString: SD card is not installed!");
+                return false;
+            }
+
+            // Open Stream
+            std::ofstream file("/usd/" + fileName);
+            if (!file.is_open())
+            {
+                Logger::error("SDCard::writeFromString: Failed to open " + fileName);
+                return false;
+            }
+
+            // Write Data
+            file << data;
+            file.close();
+            return true;
+        }
     };
 }
\ No newline at end of file
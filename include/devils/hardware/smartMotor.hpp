@@ -1,6 +1,8 @@
 #pragma once
 #include "pros/motors.hpp"
+#include "pros/rtos.hpp"
 #include "motor.hpp"
+#include "battery.hpp"
 #include "../utils/logger.hpp"
 #include <string>
 
@@ -27,14 +29,33 @@ namespace devils
 
         /**
          * Runs the motor in voltage mode.
+         * The voltage is scaled to the nominal battery voltage by `Battery::compensate`.
          * @param voltage The voltage to run the motor at, from -1 to 1.
          */
         void moveVoltage(double voltage) override
         {
-            // Move Motor
-            int32_t status = motor.move(voltage * 127);
-            if (status != 1 && LOGGING_ENABLED)
-                Logger::error(name + ": motor move failed");
+            _sendVoltage(voltage);
+            _checkHealth();
+        }
+
+        /**
+         * Runs the motor in velocity mode using the motor's onboard velocity controller.
+         * @param velocity The velocity to run the motor at in RPM.
+         */
+        void moveVelocity(double velocity) override
+        {
+            _sendVelocity(velocity);
+            _checkHealth();
+        }
+
+        /**
+         * Moves the motor to an absolute position using the motor's onboard position controller.
+         * @param position The position to move to in encoder ticks.
+         * @param maxVelocity The maximum velocity of the move in RPM.
+         */
+        void movePosition(double position, double maxVelocity) override
+        {
+            _sendPosition(position, maxVelocity);
             _checkHealth();
         }
 
@@ -42,11 +63,53 @@ namespace devils
          * Stops the motor.
          */
         void stop() override
+        {
+            _sendStop();
+            _checkHealth();
+        }
+
+        /**
+         * Sends a voltage command without checking the motor health.
+         * @param voltage The voltage to run the motor at, from -1 to 1.
+         */
+        void _sendVoltage(double voltage)
+        {
+            int32_t status = motor.move(Battery::compensate(voltage) * 127);
+            if (status != 1 && LOGGING_ENABLED)
+                Logger::error(name + ": motor move failed");
+        }
+
+        /**
+         * Sends a velocity command without checking the motor health.
+         * @param velocity The velocity to run the motor at in RPM.
+         */
+        void _sendVelocity(double velocity)
+        {
+            int32_t status = motor.move_velocity(velocity);
+            if (status != 1 && LOGGING_ENABLED)
+                Logger::error(name + ": motor move velocity failed");
+        }
+
+        /**
+         * Sends a position command without checking the motor health.
+         * @param position The position to move to in encoder ticks.
+         * @param maxVelocity The maximum velocity of the move in RPM.
+         */
+        void _sendPosition(double position, double maxVelocity)
+        {
+            int32_t status = motor.move_absolute(position, maxVelocity);
+            if (status != 1 && LOGGING_ENABLED)
+                Logger::error(name + ": motor move position failed");
+        }
+
+        /**
+         * Sends a brake command without checking the motor health.
+         */
+        void _sendStop()
         {
             int32_t status = motor.brake();
             if (status != 1 && LOGGING_ENABLED)
                 Logger::error(name + ": motor brake failed");
-            _checkHealth();
         }
 
         /**
@@ -67,7 +130,7 @@ namespace devils
         /**
          * Returns the current speed of the motor in RPM.
          */
-        double getVelocity()
+        double getVelocity() override
         {
             double velocity = motor.get_actual_velocity();
             if (velocity == PROS_ERR_F && LOGGING_ENABLED)
@@ -88,9 +151,15 @@ namespace devils
 
         /**
          * Checks and logs the current health of the motor. Should be called after every motor command (move, stop, etc).
+         * Only reads the motor once every `HEALTH_CHECK_PERIOD`, so it stays cheap in fast loops.
          */
         void _checkHealth()
         {
+            uint32_t now = pros::millis();
+            if (lastHealthCheckTime != 0 && now - lastHealthCheckTime < HEALTH_CHECK_PERIOD)
+                return;
+            lastHealthCheckTime = now;
+
             int32_t isOverTemp = motor.is_over_temp();
             int32_t isOverCurrent = motor.is_over_current();
 
@@ -121,8 +190,10 @@ namespace devils
 
     private:
         static constexpr bool LOGGING_ENABLED = true;
+        static constexpr uint32_t HEALTH_CHECK_PERIOD = 100; // ms
 
         double currentVoltage = 0;
+        uint32_t lastHealthCheckTime = 0;
         std::string name;
         pros::Motor motor;
     };
@@ -7,6 +7,8 @@ namespace devils
 {
     /**
      * Represents a set of smart motors grouped together.
+     * Commands are sent to every motor back-to-back before any health checks,
+     * so all motors in the group pick up the command in the same device cycle.
      */
     class SmartMotorGroup : public IMotor
     {
@@ -31,7 +33,31 @@ namespace devils
         void moveVoltage(double voltage) override
         {
             for (auto motor : motors)
-                motor->moveVoltage(voltage);
+                motor->_sendVoltage(voltage);
+            _checkHealth();
+        }
+
+        /**
+         * Runs all the motors in velocity mode using their onboard velocity controllers.
+         * @param velocity The velocity to run the motors at in RPM.
+         */
+        void moveVelocity(double velocity) override
+        {
+            for (auto motor : motors)
+                motor->_sendVelocity(velocity);
+            _checkHealth();
+        }
+
+        /**
+         * Moves all the motors to an absolute position using their onboard position controllers.
+         * @param position The position to move to in encoder ticks.
+         * @param maxVelocity The maximum velocity of the move in RPM.
+         */
+        void movePosition(double position, double maxVelocity) override
+        {
+            for (auto motor : motors)
+                motor->_sendPosition(position, maxVelocity);
+            _checkHealth();
         }
 
         /**
@@ -40,7 +66,17 @@ namespace devils
         void stop() override
         {
             for (auto motor : motors)
-                motor->stop();
+                motor->_sendStop();
+            _checkHealth();
+        }
+
+        /**
+         * Checks the health of each motor. Called after the command has been sent to every motor.
+         */
+        void _checkHealth()
+        {
+            for (auto motor : motors)
+                motor->_checkHealth();
         }
 
         /**
@@ -59,7 +95,7 @@ namespace devils
          * Returns the average speed of all the motors in RPM.
          * @return The average speed of all the motors in RPM.
          */
-        double getVelocity()
+        double getVelocity() override
         {
             double speed = 0;
             for (auto motor : motors)
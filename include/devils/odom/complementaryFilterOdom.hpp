@@ -1,15 +1,23 @@
 #pragma once
 #include "pros/gps.hpp"
 #include "odomSource.hpp"
+#include "slipDetector.hpp"
 #include "../geometry/pose.hpp"
 #include "../geometry/units.hpp"
 #include "../utils/logger.hpp"
+#include "../utils/profiler.hpp"
 #include "../utils/runnable.hpp"
+#include "../utils/seqLock.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 
 namespace devils
 {
     /**
      * Represents a set of odometry sources fused together using the complementary filter.
+     * The absolute source nudges a correction that is added to the relative pose.
+     * The relative source itself is left alone, so its pose history stays continuous for matching delayed measurements.
      */
     class ComplementaryFilterOdom : public OdomSource, public Runnable
     {
@@ -23,8 +31,7 @@ namespace devils
         ComplementaryFilterOdom(OdomSource *absoluteOdom, OdomSource *relativeOdom, double absoluteWeight)
             : absoluteOdom(absoluteOdom),
               relativeOdom(relativeOdom),
-              absoluteWeight(absoluteWeight),
-              relativeWeight(1 - absoluteWeight)
+              absoluteWeight(absoluteWeight)
         {
             if (absoluteWeight < 0 || absoluteWeight > 1)
                 throw std::invalid_argument("Absolute weight must be between 0 and 1");
@@ -35,35 +42,99 @@ namespace devils
          */
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+
+            if (hasPendingReset.exchange(false))
+            {
+                correction = Pose();
+                rejectionCount = 0;
+            }
+
             // Get the current pose from each source
-            Pose absolutePose = absoluteOdom->getPose();
-            Pose relativePose = relativeOdom->getPose();
+            PoseSample absoluteSample = absoluteOdom->getSnapshot();
+            Pose relativePose = relativeOdom->getSnapshot().getPose();
 
             // Check if the absolute pose has changed
-            if (absolutePose.x != lastAbsolutePose.x || absolutePose.y != lastAbsolutePose.y) // Ignore GPS IMU
+            if (absoluteSample.timestamp != 0 &&
+                (absoluteSample.x != lastAbsolutePose.x || absoluteSample.y != lastAbsolutePose.y)) // Ignore GPS IMU
             {
-                // Update the last absolute pose
-                lastAbsolutePose = absolutePose;
+                lastAbsolutePose = absoluteSample.getPose();
+                _correct(absoluteSample);
+            }
 
-                // Weight the absolute and relative poses
-                currentPose = absolutePose * absoluteWeight + relativePose * relativeWeight;
+            // Apply the correction to the relative pose
+            // Use IMU for rotation
+            currentPose = Pose(relativePose.x + correction.x, relativePose.y + correction.y, relativePose.rotation);
 
-                // Weight the absolute and relative rotations.
-                // Accounts for normalization in the rotation.
-                // double diffRad = Units::diffRad(absolutePose.rotation, relativePose.rotation);
-                // currentPose.rotation = Units::normalizeRadians(relativePose.rotation + diffRad * absoluteWeight);
+            // Publish
+            snapshot.write(PoseSample{pros::millis(), currentPose.x, currentPose.y, currentPose.rotation});
+        }
 
-                // Use IMU for rotation
-                currentPose.rotation = relativePose.rotation;
+        /**
+         * Blends an absolute measurement into the correction applied to the relative pose.
+         * The measurement is compared to the fused pose at the time it was measured, so latency does not read as error.
+         * Measurements far outside the absolute source's reported error are rejected,
+         * unless they keep disagreeing for long enough that the relative pose is more likely to be wrong.
+         * @param absoluteSample The absolute measurement.
+         */
+        void _correct(PoseSample &absoluteSample)
+        {
+            Pose pastPose = relativeOdom->getPoseAt(absoluteSample.timestamp);
+            double errorX = absoluteSample.x - (pastPose.x + correction.x);
+            double errorY = absoluteSample.y - (pastPose.y + correction.y);
 
-                // Update Relative Odometry
-                relativeOdom->setPose(currentPose);
+            // Gate
+            // The wheels are expected to disagree while they slip, so skip the gate
+            bool isSlipping = slipDetector != nullptr && slipDetector->isSlipping();
+            double gate = GATE_DISTANCE + GATE_ERROR_SCALE * absoluteSample.positionError;
+            if (!isSlipping && std::hypot(errorX, errorY) > gate)
+            {
+                rejectionCount++;
+                if (rejectionCount < MAX_REJECTIONS)
+                    return;
+                if (rejectionCount == MAX_REJECTIONS)
+                    Logger::warn("ComplementaryFilterOdom: absolute odometry keeps disagreeing, accepting it");
             }
             else
             {
-                // Apply the relative pose
-                currentPose = relativePose;
+                rejectionCount = 0;
+            }
+
+            // Trust the absolute source more when it reports a low error
+            double weight = absoluteWeight;
+            if (absoluteSample.positionError > 0)
+            {
+                double qualityScale = std::min(REFERENCE_ERROR / absoluteSample.positionError, MAX_QUALITY_SCALE);
+                weight = std::min(absoluteWeight * qualityScale, 1.0);
             }
+            if (isSlipping)
+                weight = std::min(weight * SLIP_WEIGHT_SCALE, 1.0);
+
+            correction.x += errorX * weight;
+            correction.y += errorY * weight;
+        }
+
+        /**
+         * Trusts the absolute source more while the slip detector reports that the wheels are slipping.
+         * The slip detector should compare against the relative source.
+         * @param slipDetector The slip detector to use.
+         */
+        void useSlipDetector(SlipDetector &slipDetector)
+        {
+            this->slipDetector = &slipDetector;
+        }
+
+        /**
+         * Gets the latest fused pose published by `ComplementaryFilterOdom::update`.
+         * Falls back to `getPose()` before the first update.
+         * @return The latest pose of the robot.
+         */
+        PoseSample getSnapshot() override
+        {
+            PoseSample sample = snapshot.read();
+            if (sample.timestamp == 0)
+                return _getPoseSnapshot();
+            return sample;
         }
 
         /**
@@ -82,17 +153,31 @@ namespace devils
         void setPose(Pose &pose) override
         {
             currentPose = pose;
+            hasPendingReset = true;
             absoluteOdom->setPose(pose);
             relativeOdom->setPose(pose);
         }
 
     private:
+        inline static ProfileSite updateProfile = ProfileSite("ComplementaryFilterOdom.update");
+
+        static constexpr double GATE_DISTANCE = 6.0;     // in
+        static constexpr double GATE_ERROR_SCALE = 3.0;  // standard deviations
+        static constexpr double REFERENCE_ERROR = 1.0;   // in
+        static constexpr double MAX_QUALITY_SCALE = 5.0; // %
+        static constexpr double SLIP_WEIGHT_SCALE = 4.0; // %
+        static constexpr int MAX_REJECTIONS = 50;
+
         OdomSource *absoluteOdom;
         OdomSource *relativeOdom;
         double absoluteWeight;
-        double relativeWeight;
+        SlipDetector *slipDetector = nullptr;
 
         Pose lastAbsolutePose = Pose(0, 0, 0);
         Pose currentPose = Pose(0, 0, 0);
+        Pose correction = Pose(0, 0, 0);
+        int rejectionCount = 0;
+        std::atomic<bool> hasPendingReset = false;
+        SeqLock<PoseSample> snapshot;
     };
 }
\ No newline at end of file
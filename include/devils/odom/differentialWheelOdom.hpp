@@ -3,8 +3,12 @@
 #include "../hardware/imu.hpp"
 #include "../hardware/rotationSensor.hpp"
 #include "../utils/logger.hpp"
+#include "../utils/profiler.hpp"
 #include "../geometry/pose.hpp"
 #include "odomSource.hpp"
+#include "poseHistory.hpp"
+#include "../utils/seqLock.hpp"
+#include <atomic>
 #include "pros/rtos.hpp"
 #include "pros/error.h"
 #include <cmath>
@@ -65,8 +69,10 @@ namespace devils
         void _updateRotations(double leftRotations, double rightRotations)
         {
             // Get Delta Time
-            uint32_t deltaT = lastUpdateTimestamp - pros::millis();
-            lastUpdateTimestamp = pros::millis();
+            uint32_t now = pros::millis();
+            uint32_t deltaT = now - lastUpdateTimestamp;
+            lastUpdateTimestamp = now;
+            Pose lastPose = currentPose;
 
             // Get Distance
             double left = leftRotations * 2 * M_PI * wheelRadius;
@@ -82,17 +88,33 @@ namespace devils
             double deltaDistance = (deltaLeft + deltaRight) / 2;
             double deltaRotation = (deltaLeft - deltaRight) / wheelBase;
 
-            // Calculate Delta X and Y
-            double deltaX = deltaDistance * std::cos(currentPose.rotation + deltaRotation / 2);
-            double deltaY = deltaDistance * std::sin(currentPose.rotation + deltaRotation / 2);
+            // Use the IMU for rotation when available
+            double imuHeading = imu != nullptr ? imu->getHeading() : PROS_ERR_F;
+            if (imuHeading != PROS_ERR_F)
+                deltaRotation = Units::diffRad(imuHeading, currentPose.rotation);
 
             // Update X, Y, and Rotation
-            currentPose.x += deltaX;
-            currentPose.y += deltaY;
-            currentPose.rotation += deltaRotation;
+            currentPose = currentPose.integrateArc(deltaDistance, 0, deltaRotation);
+            if (imuHeading != PROS_ERR_F)
+                currentPose.rotation = imuHeading;
+
+            // Update Velocity
+            if (deltaT > 0)
+            {
+                double velocityX = (currentPose.x - lastPose.x) * 1000.0 / deltaT;
+                double velocityY = (currentPose.y - lastPose.y) * 1000.0 / deltaT;
+                double velocityRotation = Units::diffRad(currentPose.rotation, lastPose.rotation) * 1000.0 / deltaT;
+                currentVelocity.x += (velocityX - currentVelocity.x) * VELOCITY_FILTER_GAIN;
+                currentVelocity.y += (velocityY - currentVelocity.y) * VELOCITY_FILTER_GAIN;
+                currentVelocity.rotation += (velocityRotation - currentVelocity.rotation) * VELOCITY_FILTER_GAIN;
+            }
 
-            // Update IMU
-            _updateIMU();
+            // Publish
+            PoseSample sample = PoseSample{now,
+                                           currentPose.x, currentPose.y, currentPose.rotation,
+                                           currentVelocity.x, currentVelocity.y, currentVelocity.rotation};
+            history.record(sample);
+            snapshot.write(sample);
         }
 
         /**
@@ -119,24 +141,15 @@ namespace devils
 
         void update() override
         {
+            ScopedTimer timer(updateProfile);
+
+            _applyPendingPose();
             if (chassis != nullptr)
                 _updateChassis(*chassis);
             else if (leftSensor != nullptr && rightSensor != nullptr)
                 _updateOdomWheels(*leftSensor, *rightSensor);
         }
 
-        /**
-         * Updates the rotation from an IMU specified in `useIMU`.
-         */
-        void _updateIMU()
-        {
-            if (imu == nullptr)
-                return;
-            double heading = imu->getHeading();
-            if (heading != PROS_ERR_F)
-                currentPose.rotation = heading;
-        }
-
         /**
          * Enables the IMU for the odometry.
          * @param imu The IMU to use.
@@ -156,13 +169,77 @@ namespace devils
 
         /**
          * Sets the current pose of the robot.
+         * The pose is applied by the odometry task on its next update, so it is safe to call from any task.
          * @param pose The pose to set the robot to.
          */
         void setPose(Pose &pose) override
         {
-            currentPose = pose;
+            pendingPoseMutex.take();
+            pendingPose = pose;
+            hasPendingPose = true;
+            pendingPoseMutex.give();
+        }
+
+        /**
+         * Applies a pose from `setPose`. Called from the odometry task.
+         */
+        void _applyPendingPose()
+        {
+            if (!hasPendingPose)
+                return;
+
+            pendingPoseMutex.take();
+            currentPose = pendingPose;
+            hasPendingPose = false;
+            pendingPoseMutex.give();
+
+            currentVelocity = Pose();
+            history.clear();
             if (imu != nullptr)
-                imu->setHeading(pose.rotation);
+                imu->setHeading(currentPose.rotation);
+        }
+
+        /**
+         * Gets the latest pose published by the odometry task.
+         * Falls back to `getPose()` before the first update.
+         * @return The latest pose and velocity of the robot.
+         */
+        PoseSample getSnapshot() override
+        {
+            PoseSample sample = snapshot.read();
+            if (sample.timestamp == 0)
+                return _getPoseSnapshot();
+            return sample;
+        }
+
+        /**
+         * Gets the velocity of the robot in field coordinates.
+         * @return The velocity in inches per second, with `rotation` in radians per second.
+         */
+        Pose getVelocity() override
+        {
+            return currentVelocity;
+        }
+
+        /**
+         * Gets the pose of the robot at a past time, interpolated from the pose history.
+         * @param timestamp The time to look up in milliseconds, from `pros::millis()`.
+         * @return The pose of the robot at the timestamp.
+         */
+        Pose getPoseAt(uint32_t timestamp) override
+        {
+            if (history.getSize() == 0)
+                return currentPose;
+            return history.getPoseAt(timestamp);
+        }
+
+        /**
+         * Gets the timestamped pose history.
+         * @return The pose history.
+         */
+        PoseHistory &getHistory()
+        {
+            return history;
         }
 
         /**
@@ -176,6 +253,10 @@ namespace devils
         }
 
     private:
+        inline static ProfileSite updateProfile = ProfileSite("DifferentialWheelOdometry.update");
+
+        static constexpr double VELOCITY_FILTER_GAIN = 0.5; // %
+
         const double wheelRadius;
         const double wheelBase;
 
@@ -184,6 +265,12 @@ namespace devils
         RotationSensor *rightSensor = nullptr;
 
         Pose currentPose = Pose();
+        Pose currentVelocity = Pose();
+        PoseHistory history;
+        SeqLock<PoseSample> snapshot;
+        Pose pendingPose = Pose();
+        std::atomic<bool> hasPendingPose = false;
+        pros::Mutex pendingPoseMutex;
         uint32_t lastUpdateTimestamp = 0;
 
         double lastLeft = 0;
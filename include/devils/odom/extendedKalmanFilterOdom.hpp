@@ -0,0 +1,501 @@
+#pragma once
+#include "Eigen/Dense"
+#include "pros/rtos.hpp"
+#include "pros/error.h"
+#include "odomSource.hpp"
+#include "poseHistory.hpp"
+#include "slipDetector.hpp"
+#include "../hardware/imu.hpp"
+#include "../geometry/pose.hpp"
+#include "../geometry/units.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/profiler.hpp"
+#include "../utils/runnable.hpp"
+#include "../utils/seqLock.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace devils
+{
+    /**
+     * Represents a set of odometry sources fused together using an extended Kalman filter.
+     *
+     * The state is the pose and speed of the robot: x, y, theta, forward velocity and angular velocity.
+     * Wheel odometry and the IMU yaw rate drive the prediction step, while the IMU heading and GPS pose correct it.
+     * Each sensor has its own noise, so a noisy GPS nudges the estimate while a precise IMU heading holds it.
+     * All matrices are fixed-size, so updating the filter never allocates.
+     */
+    class ExtendedKalmanFilterOdom : public OdomSource, public Runnable
+    {
+    public:
+        /// @brief The number of values in the filter state.
+        static constexpr int STATE_SIZE = 5;
+
+        /// @brief The filter state: x, y, theta, forward velocity and angular velocity.
+        typedef Eigen::Matrix<double, STATE_SIZE, 1> State;
+        /// @brief The covariance of the filter state.
+        typedef Eigen::Matrix<double, STATE_SIZE, STATE_SIZE> Covariance;
+
+        /// @brief Indices of each value in the state.
+        enum StateIndex
+        {
+            X = 0,
+            Y = 1,
+            THETA = 2,
+            VELOCITY = 3,
+            ANGULAR_VELOCITY = 4
+        };
+
+        /**
+         * Creates a new fused odometry source using an extended Kalman filter.
+         * @param wheelOdom The wheel odometry source, used to predict the robot's motion.
+         * @param imu The IMU, used for yaw rate and heading. Can be `nullptr`.
+         * @param gps The absolute odometry source, used to correct the pose. Can be `nullptr`.
+         */
+        ExtendedKalmanFilterOdom(OdomSource *wheelOdom, IMU *imu = nullptr, OdomSource *gps = nullptr)
+            : wheelOdom(wheelOdom),
+              imu(imu),
+              gps(gps)
+        {
+            if (wheelOdom == nullptr)
+                throw std::invalid_argument("Wheel odometry is required");
+            _resetState(Pose());
+            lastUpdateTimestamp = pros::millis();
+        }
+
+        /**
+         * Updates the filter with the latest data from each sensor.
+         */
+        void update() override
+        {
+            ScopedTimer timer(updateProfile);
+
+            _applyPendingPose();
+
+            // Get Delta Time
+            uint32_t now = pros::millis();
+            double deltaT = (now - lastUpdateTimestamp) / 1000.0;
+            lastUpdateTimestamp = now;
+
+            // Filter
+            _updateWheels();
+            _predict(deltaT);
+            _correctIMU();
+            _correctGPS();
+
+            // Publish
+            currentPose = Pose(state(X), state(Y), state(THETA));
+            Estimate estimate;
+            estimate.sample = PoseSample{now,
+                                         state(X), state(Y), state(THETA),
+                                         state(VELOCITY) * std::cos(state(THETA)),
+                                         state(VELOCITY) * std::sin(state(THETA)),
+                                         state(ANGULAR_VELOCITY)};
+            Eigen::Map<Covariance>(estimate.covariance) = covariance;
+            published.write(estimate);
+        }
+
+        /**
+         * Gets the current pose of the robot.
+         * @return The current pose of the robot.
+         */
+        Pose &getPose() override
+        {
+            return currentPose;
+        }
+
+        /**
+         * Sets the current pose of the robot and resets the filter's uncertainty.
+         * The pose is applied by the filter task on its next update, so it is safe to call from any task.
+         * @param pose The pose to set the robot to.
+         */
+        void setPose(Pose &pose) override
+        {
+            pendingPoseMutex.take();
+            pendingPose = pose;
+            hasPendingPose = true;
+            pendingPoseMutex.give();
+
+            wheelOdom->setPose(pose);
+            if (gps != nullptr)
+                gps->setPose(pose);
+        }
+
+        /**
+         * Gets the latest estimate published by `ExtendedKalmanFilterOdom::update`.
+         * Falls back to `getPose()` before the first update.
+         * @return The latest pose and velocity of the robot.
+         */
+        PoseSample getSnapshot() override
+        {
+            PoseSample sample = published.read().sample;
+            if (sample.timestamp == 0)
+                return _getPoseSnapshot();
+            return sample;
+        }
+
+        /**
+         * Gets the velocity of the robot in field coordinates.
+         * @return The velocity in inches per second, with `rotation` in radians per second.
+         */
+        Pose getVelocity() override
+        {
+            return getSnapshot().getVelocity();
+        }
+
+        /**
+         * Gets the covariance of the latest published estimate. Safe to call from any task.
+         * Rows and columns are ordered by `StateIndex`, in inches and radians.
+         * @return The covariance of the latest estimate.
+         */
+        Covariance getCovariance()
+        {
+            Estimate estimate = published.read();
+            return Eigen::Map<Covariance>(estimate.covariance);
+        }
+
+        /**
+         * Sets the noise of the wheel odometry.
+         * @param velocityStdDev The standard deviation of the wheel velocity in inches per second.
+         * @param yawRateStdDev The standard deviation of the wheel yaw rate in radians per second. Unused if an IMU is given.
+         */
+        void setWheelNoise(double velocityStdDev, double yawRateStdDev)
+        {
+            wheelVelocityVariance = velocityStdDev * velocityStdDev;
+            wheelYawRateVariance = yawRateStdDev * yawRateStdDev;
+        }
+
+        /**
+         * Sets the noise of the IMU.
+         * @param yawRateStdDev The standard deviation of the yaw rate in radians per second.
+         * @param headingStdDev The standard deviation of the heading in radians.
+         */
+        void setIMUNoise(double yawRateStdDev, double headingStdDev)
+        {
+            imuYawRateVariance = yawRateStdDev * yawRateStdDev;
+            imuHeadingVariance = headingStdDev * headingStdDev;
+        }
+
+        /**
+         * Sets the noise of the GPS.
+         * @param positionStdDev The standard deviation of the x and y position in inches.
+         * @param headingStdDev The standard deviation of the heading in radians, or `INFINITY` to ignore the GPS heading.
+         */
+        void setGPSNoise(double positionStdDev, double headingStdDev)
+        {
+            gpsPositionVariance = positionStdDev * positionStdDev;
+            gpsHeadingVariance = headingStdDev * headingStdDev;
+        }
+
+        /**
+         * Inflates the wheel noise while the slip detector reports that the wheels are slipping,
+         * so the IMU and GPS carry the estimate until the wheels grip again.
+         * @param slipDetector The slip detector to use. Should compare against the wheel odometry.
+         */
+        void useSlipDetector(SlipDetector &slipDetector)
+        {
+            this->slipDetector = &slipDetector;
+        }
+
+    private:
+        /**
+         * The published estimate. Kept as plain values so it can be shared through a `SeqLock`.
+         */
+        struct Estimate
+        {
+            PoseSample sample;
+            double covariance[STATE_SIZE * STATE_SIZE] = {0};
+        };
+
+        /**
+         * Resets the state to a pose with the initial uncertainty.
+         * @param pose The pose to reset to.
+         */
+        void _resetState(Pose pose)
+        {
+            state << pose.x, pose.y, pose.rotation, 0, 0;
+            covariance = Covariance::Zero();
+            covariance(X, X) = INITIAL_POSITION_VARIANCE;
+            covariance(Y, Y) = INITIAL_POSITION_VARIANCE;
+            covariance(THETA, THETA) = INITIAL_HEADING_VARIANCE;
+            covariance(VELOCITY, VELOCITY) = wheelVelocityVariance;
+            covariance(ANGULAR_VELOCITY, ANGULAR_VELOCITY) = wheelYawRateVariance;
+            currentPose = pose;
+        }
+
+        /**
+         * Applies a pose from `setPose`. Called from the filter task.
+         */
+        void _applyPendingPose()
+        {
+            if (!hasPendingPose)
+                return;
+
+            pendingPoseMutex.take();
+            Pose pose = pendingPose;
+            hasPendingPose = false;
+            pendingPoseMutex.give();
+
+            _resetState(pose);
+            lastWheelSample = PoseSample();
+            lastGPSSample = PoseSample();
+            if (imu != nullptr)
+                imu->setHeading(pose.rotation);
+        }
+
+        /**
+         * Measures the forward velocity and yaw rate from the change in the wheel odometry pose.
+         * Jumps in the wheel pose, such as from `setPose`, are ignored.
+         */
+        void _updateWheels()
+        {
+            PoseSample sample = wheelOdom->getSnapshot();
+            if (sample.timestamp == lastWheelSample.timestamp)
+                return;
+
+            bool hasLastSample = lastWheelSample.timestamp != 0;
+            PoseSample lastSample = lastWheelSample;
+            lastWheelSample = sample;
+            if (!hasLastSample)
+                return;
+
+            // Project the motion onto the average heading
+            double deltaT = (sample.timestamp - lastSample.timestamp) / 1000.0;
+            double deltaRotation = Units::diffRad(sample.rotation, lastSample.rotation);
+            double heading = lastSample.rotation + deltaRotation / 2;
+            double deltaDistance = (sample.x - lastSample.x) * std::cos(heading) +
+                                   (sample.y - lastSample.y) * std::sin(heading);
+
+            double velocity = deltaDistance / deltaT;
+            double yawRate = deltaRotation / deltaT;
+            if (std::abs(velocity) > MAX_WHEEL_VELOCITY || std::abs(yawRate) > MAX_WHEEL_YAW_RATE)
+                return;
+
+            wheelVelocity = velocity;
+            wheelYawRate = yawRate;
+        }
+
+        /**
+         * Predicts the state forward using the wheel velocity and the IMU yaw rate.
+         * @param deltaT The time since the last prediction in seconds.
+         */
+        void _predict(double deltaT)
+        {
+            // Inputs
+            double slipScale = slipDetector != nullptr && slipDetector->isSlipping() ? SLIP_VARIANCE_SCALE : 1.0;
+            double velocityVariance = wheelVelocityVariance * slipScale;
+            double yawRate = wheelYawRate;
+            double yawRateVariance = wheelYawRateVariance * slipScale;
+            if (imu != nullptr)
+            {
+                double imuYawRate = imu->getYawRate();
+                if (imuYawRate != PROS_ERR_F)
+                {
+                    yawRate = imuYawRate;
+                    yawRateVariance = imuYawRateVariance;
+                }
+            }
+
+            // The velocities are measured, so they replace the previous estimate
+            state(VELOCITY) = wheelVelocity;
+            state(ANGULAR_VELOCITY) = yawRate;
+            covariance.row(VELOCITY).setZero();
+            covariance.col(VELOCITY).setZero();
+            covariance.row(ANGULAR_VELOCITY).setZero();
+            covariance.col(ANGULAR_VELOCITY).setZero();
+            covariance(VELOCITY, VELOCITY) = velocityVariance;
+            covariance(ANGULAR_VELOCITY, ANGULAR_VELOCITY) = yawRateVariance;
+
+            // Motion Model
+            double velocity = state(VELOCITY);
+            double heading = state(THETA) + yawRate * deltaT / 2;
+            double cosHeading = std::cos(heading);
+            double sinHeading = std::sin(heading);
+
+            state(X) += velocity * deltaT * cosHeading;
+            state(Y) += velocity * deltaT * sinHeading;
+            state(THETA) = Units::normalizeRadians(state(THETA) + yawRate * deltaT);
+
+            // Jacobian
+            Covariance jacobian = Covariance::Identity();
+            jacobian(X, THETA) = -velocity * deltaT * sinHeading;
+            jacobian(X, VELOCITY) = deltaT * cosHeading;
+            jacobian(X, ANGULAR_VELOCITY) = -velocity * deltaT * deltaT / 2 * sinHeading;
+            jacobian(Y, THETA) = velocity * deltaT * cosHeading;
+            jacobian(Y, VELOCITY) = deltaT * sinHeading;
+            jacobian(Y, ANGULAR_VELOCITY) = velocity * deltaT * deltaT / 2 * cosHeading;
+            jacobian(THETA, ANGULAR_VELOCITY) = deltaT;
+
+            covariance = jacobian * covariance * jacobian.transpose();
+            covariance(X, X) += POSITION_PROCESS_NOISE * deltaT;
+            covariance(Y, Y) += POSITION_PROCESS_NOISE * deltaT;
+            covariance(THETA, THETA) += HEADING_PROCESS_NOISE * deltaT;
+        }
+
+        /**
+         * Corrects the heading with the IMU heading.
+         */
+        void _correctIMU()
+        {
+            if (imu == nullptr)
+                return;
+            double heading = imu->getHeading();
+            if (heading == PROS_ERR_F)
+                return;
+
+            Eigen::Matrix<double, 1, 1> innovation;
+            innovation << Units::diffRad(heading, state(THETA));
+
+            Eigen::Matrix<double, 1, STATE_SIZE> observation = Eigen::Matrix<double, 1, STATE_SIZE>::Zero();
+            observation(0, THETA) = 1;
+
+            Eigen::Matrix<double, 1, 1> noise;
+            noise << imuHeadingVariance;
+
+            _correct<1>(innovation, observation, noise, INFINITY);
+        }
+
+        /**
+         * Corrects the pose with the GPS pose, if the GPS has a new measurement.
+         * The GPS pose is measured in the past, so it is moved forward by the wheel motion since then.
+         * Measurements far outside the filter's uncertainty are rejected, unless the GPS disagrees for long enough
+         * that the filter is more likely to be wrong.
+         */
+        void _correctGPS()
+        {
+            if (gps == nullptr)
+                return;
+
+            // Check for a new measurement
+            PoseSample sample = gps->getSnapshot();
+            if (sample.timestamp == 0 || (sample.x == lastGPSSample.x && sample.y == lastGPSSample.y))
+                return;
+            lastGPSSample = sample;
+
+            // Latency
+            double x = sample.x;
+            double y = sample.y;
+            double rotation = sample.rotation;
+            if (lastWheelSample.timestamp != 0)
+            {
+                Pose pastWheelPose = wheelOdom->getPoseAt(sample.timestamp);
+                x += lastWheelSample.x - pastWheelPose.x;
+                y += lastWheelSample.y - pastWheelPose.y;
+                rotation += Units::diffRad(lastWheelSample.rotation, pastWheelPose.rotation);
+            }
+
+            Eigen::Matrix<double, 3, 1> innovation;
+            innovation << x - state(X),
+                y - state(Y),
+                Units::diffRad(rotation, state(THETA));
+
+            Eigen::Matrix<double, 3, STATE_SIZE> observation = Eigen::Matrix<double, 3, STATE_SIZE>::Zero();
+            observation(0, X) = 1;
+            observation(1, Y) = 1;
+            observation(2, THETA) = 1;
+
+            // Use the GPS's own error estimate when it is worse than the configured noise
+            double positionVariance = std::max(gpsPositionVariance, sample.positionError * sample.positionError);
+
+            // Ignore the GPS heading if its noise is infinite
+            Eigen::Matrix<double, 3, 1> noiseDiagonal;
+            noiseDiagonal << positionVariance, positionVariance, gpsHeadingVariance;
+            if (!std::isfinite(gpsHeadingVariance))
+            {
+                innovation(2) = 0;
+                observation(2, THETA) = 0;
+                noiseDiagonal(2) = 1;
+            }
+            Eigen::Matrix<double, 3, 3> noise = noiseDiagonal.asDiagonal();
+
+            // Gate
+            bool isForced = gpsRejectionCount >= MAX_GPS_REJECTIONS;
+            if (_correct<3>(innovation, observation, noise, isForced ? INFINITY : GPS_GATE))
+            {
+                gpsRejectionCount = 0;
+            }
+            else
+            {
+                gpsRejectionCount++;
+                if (gpsRejectionCount == MAX_GPS_REJECTIONS)
+                    Logger::warn("ExtendedKalmanFilterOdom: GPS disagrees with odometry, relocking");
+            }
+        }
+
+        /**
+         * Applies a measurement to the state using the Kalman gain.
+         * Uses the Joseph form so the covariance stays symmetric and positive definite.
+         * @tparam N The number of values in the measurement.
+         * @param innovation The difference between the measurement and the predicted measurement.
+         * @param observation The observation matrix, mapping the state to the measurement.
+         * @param noise The measurement covariance.
+         * @param gate The maximum squared Mahalanobis distance of the innovation, or `INFINITY` to always accept.
+         * @return True if the measurement was applied, false if it was rejected by the gate.
+         */
+        template <int N>
+        bool _correct(const Eigen::Matrix<double, N, 1> &innovation,
+                      const Eigen::Matrix<double, N, STATE_SIZE> &observation,
+                      const Eigen::Matrix<double, N, N> &noise,
+                      double gate)
+        {
+            Eigen::Matrix<double, N, N> innovationCovariance = observation * covariance * observation.transpose() + noise;
+            Eigen::Matrix<double, N, N> innovationInverse = innovationCovariance.inverse();
+
+            double distance = (innovation.transpose() * innovationInverse * innovation)(0, 0);
+            if (!std::isfinite(distance) || distance > gate)
+                return false;
+
+            Eigen::Matrix<double, STATE_SIZE, N> gain = covariance * observation.transpose() * innovationInverse;
+            state += gain * innovation;
+            state(THETA) = Units::normalizeRadians(state(THETA));
+
+            Covariance correction = Covariance::Identity() - gain * observation;
+            covariance = correction * covariance * correction.transpose() + gain * noise * gain.transpose();
+            return true;
+        }
+
+        inline static ProfileSite updateProfile = ProfileSite("ExtendedKalmanFilterOdom.update");
+
+        static constexpr double INITIAL_POSITION_VARIANCE = 1.0;  // in^2
+        static constexpr double INITIAL_HEADING_VARIANCE = 0.01;  // rad^2
+        static constexpr double POSITION_PROCESS_NOISE = 1.0;     // in^2/s
+        static constexpr double HEADING_PROCESS_NOISE = 0.01;     // rad^2/s
+        static constexpr double MAX_WHEEL_VELOCITY = 200.0;       // in/s
+        static constexpr double MAX_WHEEL_YAW_RATE = 20.0;        // rad/s
+        static constexpr double GPS_GATE = 11.34;                 // chi^2, 3 DOF at 99%
+        static constexpr double SLIP_VARIANCE_SCALE = 100.0;      // %
+        static constexpr int MAX_GPS_REJECTIONS = 25;
+
+        // Sources
+        OdomSource *wheelOdom;
+        IMU *imu;
+        OdomSource *gps;
+        SlipDetector *slipDetector = nullptr;
+
+        // Sensor Noise
+        double wheelVelocityVariance = 4.0;   // (in/s)^2
+        double wheelYawRateVariance = 0.04;   // (rad/s)^2
+        double imuYawRateVariance = 0.0004;   // (rad/s)^2
+        double imuHeadingVariance = 0.0001;   // rad^2
+        double gpsPositionVariance = 4.0;     // in^2
+        double gpsHeadingVariance = 0.01;     // rad^2
+
+        // Filter
+        State state;
+        Covariance covariance;
+        uint32_t lastUpdateTimestamp = 0;
+        PoseSample lastWheelSample;
+        PoseSample lastGPSSample;
+        double wheelVelocity = 0;
+        double wheelYawRate = 0;
+        int gpsRejectionCount = 0;
+
+        // Publish
+        Pose currentPose = Pose();
+        SeqLock<Estimate> published;
+        Pose pendingPose = Pose();
+        std::atomic<bool> hasPendingPose = false;
+        pros::Mutex pendingPoseMutex;
+    };
+}
\ No newline at end of file
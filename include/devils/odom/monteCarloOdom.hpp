@@ -0,0 +1,308 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "pros/error.h"
+#include "odomSource.hpp"
+#include "poseHistory.hpp"
+#include "particleFilter.hpp"
+#include "../hardware/distanceSensor.hpp"
+#include "../geometry/pose.hpp"
+#include "../geometry/units.hpp"
+#include "../path/occupancyGrid.hpp"
+#include "../utils/profiler.hpp"
+#include "../utils/runnable.hpp"
+#include "../utils/seqLock.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Represents an odometry source that localizes the robot against a map of the field using a particle filter.
+     *
+     * Wheel odometry moves the particles, while the GPS and distance sensors pointed at the walls weigh them.
+     * Unlike a Kalman filter, the particles can hold several guesses at once, so a distance reading
+     * that could come from either of two walls does not pull the estimate in between them.
+     */
+    class MonteCarloOdom : public OdomSource, public Runnable
+    {
+    public:
+        /**
+         * Creates a new Monte Carlo localization odometry source.
+         * @param wheelOdom The wheel odometry source, used to move the particles.
+         * @param occupancyGrid The occupancy grid of the field, used to predict distance sensor readings.
+         * @param gps The absolute odometry source, used to weigh the particles. Can be `nullptr`.
+         * @param particleCount The number of particles. The default is meant to fit within a 10ms odometry period with a few distance sensors.
+         */
+        MonteCarloOdom(OdomSource *wheelOdom,
+                       OccupancyGrid &occupancyGrid,
+                       OdomSource *gps = nullptr,
+                       int particleCount = DEFAULT_PARTICLE_COUNT)
+            : wheelOdom(wheelOdom),
+              gps(gps),
+              filter(particleCount, pros::millis())
+        {
+            if (wheelOdom == nullptr)
+                throw std::invalid_argument("Wheel odometry is required");
+            filter.useOccupancyGrid(occupancyGrid);
+            filter.reset(Pose(), INITIAL_POSITION_STD_DEV, INITIAL_ROTATION_STD_DEV);
+        }
+
+        /**
+         * Adds a distance sensor pointed at the field walls or field elements.
+         * @param sensor The distance sensor.
+         * @param offset The pose of the sensor relative to the center of the robot.
+         *               `x` is forward, `y` is toward the side that positive rotation turns to,
+         *               and `rotation` is the direction the sensor faces relative to the robot's heading in radians.
+         */
+        void addDistanceSensor(DistanceSensor &sensor, Pose offset)
+        {
+            distanceSensors.push_back(DistanceSensorMount{&sensor, offset});
+        }
+
+        void update() override
+        {
+            ScopedTimer timer(updateProfile);
+
+            _applyPendingPose();
+
+            uint32_t now = pros::millis();
+            _updateWheels();
+            _correctGPS();
+            if (now - lastDistanceTimestamp >= DISTANCE_PERIOD)
+            {
+                lastDistanceTimestamp = now;
+                _correctDistance();
+            }
+            filter.resample();
+
+            // Publish
+            currentPose = filter.getEstimate();
+            PoseSample sample = PoseSample{now,
+                                           currentPose.x, currentPose.y, currentPose.rotation,
+                                           lastWheelSample.velocityX, lastWheelSample.velocityY, lastWheelSample.velocityRotation,
+                                           filter.getPositionError()};
+            history.record(sample);
+            snapshot.write(sample);
+        }
+
+        /**
+         * Moves the particles by the change in the wheel odometry since the last update.
+         */
+        void _updateWheels()
+        {
+            PoseSample sample = wheelOdom->getSnapshot();
+            if (sample.timestamp == lastWheelSample.timestamp)
+                return;
+
+            bool hasLastSample = lastWheelSample.timestamp != 0;
+            PoseSample lastSample = lastWheelSample;
+            lastWheelSample = sample;
+            if (!hasLastSample)
+                return;
+
+            // Convert the motion to the robot's frame around the average heading
+            double deltaX = sample.x - lastSample.x;
+            double deltaY = sample.y - lastSample.y;
+            double deltaRotation = Units::diffRad(sample.rotation, lastSample.rotation);
+            double heading = lastSample.rotation + deltaRotation / 2;
+            double forward = deltaX * std::cos(heading) + deltaY * std::sin(heading);
+            double lateral = -deltaX * std::sin(heading) + deltaY * std::cos(heading);
+
+            filter.predict(forward, lateral, deltaRotation);
+        }
+
+        /**
+         * Weighs the particles by the GPS, if it has a new measurement.
+         * The GPS pose is measured in the past, so it is moved forward by the wheel motion since then.
+         */
+        void _correctGPS()
+        {
+            if (gps == nullptr)
+                return;
+
+            // Check for a new measurement
+            PoseSample sample = gps->getSnapshot();
+            if (sample.timestamp == 0 || (sample.x == lastGPSSample.x && sample.y == lastGPSSample.y))
+                return;
+            lastGPSSample = sample;
+
+            // Latency
+            double x = sample.x;
+            double y = sample.y;
+            if (lastWheelSample.timestamp != 0)
+            {
+                Pose pastWheelPose = wheelOdom->getPoseAt(sample.timestamp);
+                x += lastWheelSample.x - pastWheelPose.x;
+                y += lastWheelSample.y - pastWheelPose.y;
+            }
+
+            filter.correctPosition(x, y, std::max(gpsStdDev, sample.positionError));
+        }
+
+        /**
+         * Weighs the particles by each distance sensor that sees something within range.
+         */
+        void _correctDistance()
+        {
+            for (DistanceSensorMount &mount : distanceSensors)
+            {
+                double distance = mount.sensor->getDistance();
+                if (distance == PROS_ERR_F || distance > MAX_DISTANCE)
+                    continue;
+                filter.correctDistance(mount.offset, distance, distanceStdDev, MAX_DISTANCE);
+            }
+        }
+
+        /**
+         * Gets the current pose of the robot.
+         * @return The current pose of the robot.
+         */
+        Pose &getPose() override
+        {
+            return currentPose;
+        }
+
+        /**
+         * Sets the current pose of the robot and gathers the particles around it.
+         * The pose is applied by the odometry task on its next update, so it is safe to call from any task.
+         * @param pose The pose to set the robot to.
+         */
+        void setPose(Pose &pose) override
+        {
+            pendingPoseMutex.take();
+            pendingPose = pose;
+            hasPendingPose = true;
+            pendingPoseMutex.give();
+
+            wheelOdom->setPose(pose);
+            if (gps != nullptr)
+                gps->setPose(pose);
+        }
+
+        /**
+         * Applies a pose from `setPose`. Called from the odometry task.
+         */
+        void _applyPendingPose()
+        {
+            if (!hasPendingPose)
+                return;
+
+            pendingPoseMutex.take();
+            Pose pose = pendingPose;
+            hasPendingPose = false;
+            pendingPoseMutex.give();
+
+            filter.reset(pose, INITIAL_POSITION_STD_DEV, INITIAL_ROTATION_STD_DEV);
+            currentPose = pose;
+            lastWheelSample = PoseSample();
+            lastGPSSample = PoseSample();
+            history.clear();
+        }
+
+        /**
+         * Gets the latest estimate published by `MonteCarloOdom::update`.
+         * `positionError` is the spread of the particles.
+         * Falls back to `getPose()` before the first update.
+         * @return The latest pose and velocity of the robot.
+         */
+        PoseSample getSnapshot() override
+        {
+            PoseSample sample = snapshot.read();
+            if (sample.timestamp == 0)
+                return _getPoseSnapshot();
+            return sample;
+        }
+
+        /**
+         * Gets the velocity of the robot in field coordinates, from the wheel odometry.
+         * @return The velocity in inches per second, with `rotation` in radians per second.
+         */
+        Pose getVelocity() override
+        {
+            return getSnapshot().getVelocity();
+        }
+
+        /**
+         * Gets the pose of the robot at a past time, interpolated from the pose history.
+         * @param timestamp The time to look up in milliseconds, from `pros::millis()`.
+         * @return The pose of the robot at the timestamp.
+         */
+        Pose getPoseAt(uint32_t timestamp) override
+        {
+            if (history.getSize() == 0)
+                return currentPose;
+            return history.getPoseAt(timestamp);
+        }
+
+        /**
+         * Gets the particle filter. Only safe to use from the odometry task.
+         * @return The particle filter.
+         */
+        ParticleFilter &getParticleFilter()
+        {
+            return filter;
+        }
+
+        /**
+         * Sets the noise of the GPS.
+         * The GPS's own error estimate is used instead when it is larger.
+         * @param positionStdDev The standard deviation of the x and y position in inches.
+         */
+        void setGPSNoise(double positionStdDev)
+        {
+            gpsStdDev = positionStdDev;
+        }
+
+        /**
+         * Sets the noise of the distance sensors, including any error in the occupancy grid.
+         * @param distanceStdDev The standard deviation of the distance in inches.
+         */
+        void setDistanceNoise(double distanceStdDev)
+        {
+            this->distanceStdDev = distanceStdDev;
+        }
+
+    private:
+        /**
+         * A distance sensor and where it is mounted on the robot.
+         */
+        struct DistanceSensorMount
+        {
+            DistanceSensor *sensor;
+            Pose offset;
+        };
+
+        inline static ProfileSite updateProfile = ProfileSite("MonteCarloOdom.update");
+
+        static constexpr int DEFAULT_PARTICLE_COUNT = 200;
+        static constexpr double INITIAL_POSITION_STD_DEV = 1.0;  // in
+        static constexpr double INITIAL_ROTATION_STD_DEV = 0.05; // rad
+        static constexpr double MAX_DISTANCE = 78.0;             // in
+        static constexpr uint32_t DISTANCE_PERIOD = 50;          // ms
+
+        // Sources
+        OdomSource *wheelOdom;
+        OdomSource *gps;
+        std::vector<DistanceSensorMount> distanceSensors;
+
+        // Sensor Noise
+        double gpsStdDev = 2.0;      // in
+        double distanceStdDev = 1.5; // in
+
+        // Filter
+        ParticleFilter filter;
+        PoseSample lastWheelSample;
+        PoseSample lastGPSSample;
+        uint32_t lastDistanceTimestamp = 0;
+
+        // Publish
+        Pose currentPose = Pose();
+        PoseHistory history;
+        SeqLock<PoseSample> snapshot;
+        Pose pendingPose = Pose();
+        std::atomic<bool> hasPendingPose = false;
+        pros::Mutex pendingPoseMutex;
+    };
+}
\ No newline at end of file
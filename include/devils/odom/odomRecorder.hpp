@@ -0,0 +1,182 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "pros/error.h"
+#include "odomSource.hpp"
+#include "../hardware/distanceSensor.hpp"
+#include "../hardware/sdCard.hpp"
+#include "../geometry/pose.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/runnable.hpp"
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Records the raw localization inputs to the SD card, so odometry can be replayed and tuned off the robot
+     * with the host tools in `host/`.
+     *
+     * The log is a text file with one reading per line:
+     * - `ODOMLOG 1` starts the log.
+     * - `SENSOR index x y rotation` is the mount of each distance sensor, as passed to `MonteCarloOdom::addDistanceSensor`.
+     * - `WHEEL timestamp x y rotation` starts each update with the wheel odometry snapshot.
+     * - `GPS timestamp x y rotation error` follows when the GPS has a new snapshot.
+     * - `DISTANCE index distance` follows for each distance sensor that sees something.
+     * - `ENDODOMLOG` ends the log.
+     *
+     * Distances are in inches, rotations in radians and timestamps in milliseconds from `pros::millis()`.
+     * Should be run from the odometry task, right after the sources it records.
+     */
+    class OdomRecorder : public Runnable
+    {
+    public:
+        /**
+         * Creates a new odometry recorder.
+         * @param wheelOdom The wheel odometry source to record.
+         * @param gps The absolute odometry source to record. Can be `nullptr`.
+         */
+        OdomRecorder(OdomSource *wheelOdom, OdomSource *gps = nullptr)
+            : wheelOdom(wheelOdom),
+              gps(gps)
+        {
+            if (wheelOdom == nullptr)
+                throw std::invalid_argument("Wheel odometry is required");
+        }
+
+        ~OdomRecorder()
+        {
+            close();
+        }
+
+        /**
+         * Adds a distance sensor to record. Must be called before `OdomRecorder::open`.
+         * @param sensor The distance sensor.
+         * @param offset The pose of the sensor relative to the center of the robot.
+         */
+        void addDistanceSensor(DistanceSensor &sensor, Pose offset)
+        {
+            distanceSensors.push_back(DistanceSensorMount{&sensor, offset});
+        }
+
+        /**
+         * Opens a new log file on the SD card. Increments the index until a file that doesn't exist is found.
+         * @return True if the log file was opened, false otherwise.
+         */
+        bool open()
+        {
+            if (!SDCard::isInserted())
+            {
+                Logger::warn("OdomRecorder: SD card is not installed!");
+                return false;
+            }
+
+            // Find a new file
+            int index = 0;
+            std::string path;
+            do
+            {
+                path = "/usd/odom-" + std::to_string(index) + ".txt";
+                index++;
+            } while (std::ifstream(path).good());
+
+            file.open(path);
+            if (!file.is_open())
+            {
+                Logger::error("OdomRecorder: Failed to open log file at " + path);
+                return false;
+            }
+            Logger::info("OdomRecorder: Recording to " + path);
+
+            // Header
+            file << std::fixed << std::setprecision(4);
+            file << "ODOMLOG 1\n";
+            for (int i = 0; i < distanceSensors.size(); i++)
+            {
+                Pose &offset = distanceSensors[i].offset;
+                file << "SENSOR " << i << " " << offset.x << " " << offset.y << " " << offset.rotation << "\n";
+            }
+
+            lastWheelSample = PoseSample();
+            lastGPSSample = PoseSample();
+            lastFlushTimestamp = pros::millis();
+            return true;
+        }
+
+        /**
+         * Ends the log and closes the file.
+         */
+        void close()
+        {
+            if (!file.is_open())
+                return;
+            file << "ENDODOMLOG\n";
+            file.close();
+        }
+
+        void update() override
+        {
+            if (!file.is_open())
+                return;
+
+            // Wheels
+            PoseSample wheelSample = wheelOdom->getSnapshot();
+            if (wheelSample.timestamp == 0 || wheelSample.timestamp == lastWheelSample.timestamp)
+                return;
+            lastWheelSample = wheelSample;
+            file << "WHEEL " << wheelSample.timestamp << " "
+                 << wheelSample.x << " " << wheelSample.y << " " << wheelSample.rotation << "\n";
+
+            // GPS
+            if (gps != nullptr)
+            {
+                PoseSample gpsSample = gps->getSnapshot();
+                if (gpsSample.timestamp != 0 && gpsSample.timestamp != lastGPSSample.timestamp)
+                {
+                    lastGPSSample = gpsSample;
+                    file << "GPS " << gpsSample.timestamp << " "
+                         << gpsSample.x << " " << gpsSample.y << " " << gpsSample.rotation << " "
+                         << gpsSample.positionError << "\n";
+                }
+            }
+
+            // Distance Sensors
+            for (int i = 0; i < distanceSensors.size(); i++)
+            {
+                double distance = distanceSensors[i].sensor->getDistance();
+                if (distance != PROS_ERR_F)
+                    file << "DISTANCE " << i << " " << distance << "\n";
+            }
+
+            // Flush every so often, so a brownout only loses the last moments
+            uint32_t now = pros::millis();
+            if (now - lastFlushTimestamp >= FLUSH_PERIOD)
+            {
+                lastFlushTimestamp = now;
+                file.flush();
+            }
+        }
+
+    private:
+        /**
+         * A distance sensor and where it is mounted on the robot.
+         */
+        struct DistanceSensorMount
+        {
+            DistanceSensor *sensor;
+            Pose offset;
+        };
+
+        static constexpr uint32_t FLUSH_PERIOD = 1000; // ms
+
+        OdomSource *wheelOdom;
+        OdomSource *gps;
+        std::vector<DistanceSensorMount> distanceSensors;
+
+        std::ofstream file;
+        PoseSample lastWheelSample;
+        PoseSample lastGPSSample;
+        uint32_t lastFlushTimestamp = 0;
+    };
+}
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
+#include "pros/rtos.hpp"
 #include "../geometry/pose.hpp"
+#include "poseHistory.hpp"
+#include <cstdint>
 
 namespace devils
 {
@@ -19,5 +22,50 @@ namespace devils
          * @param pose The pose to set the robot to
          */
         virtual void setPose(Pose &pose) = 0;
+
+        /**
+         * Gets the velocity of the robot in field coordinates.
+         * Sources that do not track velocity return zero.
+         * @return The velocity in inches per second, with `rotation` in radians per second.
+         */
+        virtual Pose getVelocity()
+        {
+            return Pose();
+        }
+
+        /**
+         * Gets the pose of the robot at a past time.
+         * Sources without a pose history return the current pose.
+         * @param timestamp The time to look up in milliseconds, from `pros::millis()`.
+         * @return The pose of the robot at the timestamp.
+         */
+        virtual Pose getPoseAt(uint32_t timestamp)
+        {
+            return getPose();
+        }
+
+        /**
+         * Gets a consistent, timestamped copy of the pose that is safe to read from any task.
+         * Sources updated from their own task publish snapshots without locking, so reading never blocks the writer.
+         * Sources that do not publish snapshots copy `getPose()` instead.
+         * @return The latest pose and velocity of the robot.
+         */
+        virtual PoseSample getSnapshot()
+        {
+            Pose pose = getPose();
+            Pose velocity = getVelocity();
+            return PoseSample{pros::millis(), pose.x, pose.y, pose.rotation, velocity.x, velocity.y, velocity.rotation};
+        }
+
+        /**
+         * Copies `getPose()` into a snapshot with no velocity.
+         * Used by sources that publish snapshots, until their first update.
+         * @return The current pose of the robot, timestamped now.
+         */
+        PoseSample _getPoseSnapshot()
+        {
+            Pose pose = getPose();
+            return PoseSample{pros::millis(), pose.x, pose.y, pose.rotation};
+        }
     };
 }
\ No newline at end of file
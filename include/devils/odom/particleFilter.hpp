@@ -0,0 +1,374 @@
+#pragma once
+#include "../geometry/pose.hpp"
+#include "../path/occupancyGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * A particle filter that localizes the robot against an occupancy grid of the field.
+     *
+     * Each particle is a guess of the robot's pose. Motion moves every particle with some noise,
+     * and each measurement reweighs them by how well they explain it. Particles that explain the
+     * measurements poorly are dropped when resampling, and likely ones are duplicated.
+     *
+     * Particles are stored as separate arrays of x, y, rotation and weight, which are allocated once,
+     * so the filter never allocates after construction.
+     * Only depends on the geometry and path headers, so it can be run on recorded logs off the robot.
+     */
+    class ParticleFilter
+    {
+    public:
+        /**
+         * Creates a new particle filter. All particles start at the origin.
+         * @param particleCount The number of particles. The cost of each update is linear in this.
+         * @param seed The seed of the random number generator, so replaying a log gives the same result.
+         */
+        ParticleFilter(int particleCount, uint32_t seed = 0)
+            : particleCount(particleCount),
+              random(seed),
+              particleX(particleCount),
+              particleY(particleCount),
+              particleRotation(particleCount),
+              particleWeight(particleCount, 1.0 / particleCount),
+              resampleX(particleCount),
+              resampleY(particleCount),
+              resampleRotation(particleCount)
+        {
+        }
+
+        /**
+         * Spreads the particles around a pose and resets their weights.
+         * @param pose The pose to spread the particles around.
+         * @param positionStdDev The standard deviation of the particles' positions in inches.
+         * @param rotationStdDev The standard deviation of the particles' rotations in radians.
+         */
+        void reset(Pose pose, double positionStdDev, double rotationStdDev)
+        {
+            for (int i = 0; i < particleCount; i++)
+            {
+                particleX[i] = pose.x + positionStdDev * normal(random);
+                particleY[i] = pose.y + positionStdDev * normal(random);
+                particleRotation[i] = pose.rotation + rotationStdDev * normal(random);
+                particleWeight[i] = 1.0 / particleCount;
+            }
+        }
+
+        /**
+         * Moves every particle by a motion measured in the robot's frame, such as a wheel odometry step.
+         * Each particle gets its own noise, proportional to the motion, so the cloud spreads as the robot drives.
+         * @param forward The distance travelled along the robot's heading in inches.
+         * @param lateral The distance travelled toward the side that positive rotation turns to in inches.
+         * @param deltaRotation The change in rotation in radians.
+         */
+        void predict(double forward, double lateral, double deltaRotation)
+        {
+            double translation = std::hypot(forward, lateral);
+            double translationStdDev = translationNoise * translation;
+            double rotationStdDev = rotationNoise * std::abs(deltaRotation) + rotationFromTranslationNoise * translation;
+            bool isMoving = translation > 0 || deltaRotation != 0;
+
+            for (int i = 0; i < particleCount; i++)
+            {
+                double particleForward = forward;
+                double particleLateral = lateral;
+                double particleDeltaRotation = deltaRotation;
+                if (isMoving)
+                {
+                    particleForward += translationStdDev * normal(random);
+                    particleLateral += translationStdDev * normal(random);
+                    particleDeltaRotation += rotationStdDev * normal(random);
+                }
+
+                // Step along the average heading of the particle
+                double heading = particleRotation[i] + particleDeltaRotation / 2;
+                double cosHeading = std::cos(heading);
+                double sinHeading = std::sin(heading);
+                particleX[i] += particleForward * cosHeading - particleLateral * sinHeading;
+                particleY[i] += particleForward * sinHeading + particleLateral * cosHeading;
+                particleRotation[i] += particleDeltaRotation;
+            }
+        }
+
+        /**
+         * Weighs the particles by an absolute position measurement, such as the GPS.
+         * Part of the likelihood is uniform, so a single bad reading cannot rule out the particles near the true pose.
+         * @param x The measured x position in inches.
+         * @param y The measured y position in inches.
+         * @param stdDev The standard deviation of the measurement in inches.
+         */
+        void correctPosition(double x, double y, double stdDev)
+        {
+            double inverseVariance = 1.0 / (stdDev * stdDev);
+            for (int i = 0; i < particleCount; i++)
+            {
+                double errorX = particleX[i] - x;
+                double errorY = particleY[i] - y;
+                double likelihood = std::exp(-0.5 * (errorX * errorX + errorY * errorY) * inverseVariance);
+                particleWeight[i] *= (1 - UNMODELED_PROBABILITY) * likelihood + UNMODELED_PROBABILITY;
+            }
+            _normalize();
+        }
+
+        /**
+         * Weighs the particles by a distance sensor reading against the occupancy grid.
+         * The expected reading of each particle is found by casting a ray from the sensor until it hits an occupied cell.
+         * Part of the likelihood is uniform, so an unmapped obstacle such as another robot only weakens the update.
+         * @param sensorOffset The pose of the sensor relative to the robot.
+         *                     `x` is forward, `y` is toward the side that positive rotation turns to,
+         *                     and `rotation` is the direction the sensor faces relative to the robot's heading.
+         * @param distance The measured distance in inches.
+         * @param stdDev The standard deviation of the measurement in inches.
+         * @param maxDistance The range of the sensor in inches. Expected readings are capped at this distance.
+         */
+        void correctDistance(Pose &sensorOffset, double distance, double stdDev, double maxDistance)
+        {
+            if (occupancyGrid == nullptr || occupancyGrid->width <= 0 || occupancyGrid->height <= 0)
+                return;
+
+            double inverseVariance = 1.0 / (stdDev * stdDev);
+            for (int i = 0; i < particleCount; i++)
+            {
+                double cosRotation = std::cos(particleRotation[i]);
+                double sinRotation = std::sin(particleRotation[i]);
+                double sensorX = particleX[i] + sensorOffset.x * cosRotation - sensorOffset.y * sinRotation;
+                double sensorY = particleY[i] + sensorOffset.x * sinRotation + sensorOffset.y * cosRotation;
+
+                double expected = _raycast(sensorX, sensorY, particleRotation[i] + sensorOffset.rotation, maxDistance);
+                double error = expected - distance;
+                double likelihood = std::exp(-0.5 * error * error * inverseVariance);
+                particleWeight[i] *= (1 - UNMODELED_PROBABILITY) * likelihood + UNMODELED_PROBABILITY;
+            }
+            _normalize();
+        }
+
+        /**
+         * Resamples the particles once too few of them carry most of the weight.
+         * Uses systematic resampling: a single random offset and evenly spaced steps through the cumulative weights,
+         * which keeps the particles in proportion to their weights with less noise than drawing each one independently.
+         * @return True if the particles were resampled, false otherwise.
+         */
+        bool resample()
+        {
+            if (getEffectiveParticleCount() >= particleCount * RESAMPLE_THRESHOLD)
+                return false;
+
+            double step = 1.0 / particleCount;
+            double target = std::uniform_real_distribution<double>(0, step)(random);
+            double cumulativeWeight = particleWeight[0];
+            int source = 0;
+            for (int i = 0; i < particleCount; i++)
+            {
+                while (target > cumulativeWeight && source < particleCount - 1)
+                {
+                    source++;
+                    cumulativeWeight += particleWeight[source];
+                }
+                resampleX[i] = particleX[source];
+                resampleY[i] = particleY[source];
+                resampleRotation[i] = particleRotation[source];
+                target += step;
+            }
+
+            particleX.swap(resampleX);
+            particleY.swap(resampleY);
+            particleRotation.swap(resampleRotation);
+            std::fill(particleWeight.begin(), particleWeight.end(), step);
+            return true;
+        }
+
+        /**
+         * Gets the weighted mean pose of the particles.
+         * The rotation is averaged as a direction, so particles on either side of a wrap do not cancel out.
+         * @return The estimated pose of the robot.
+         */
+        Pose getEstimate()
+        {
+            double x = 0;
+            double y = 0;
+            double cosSum = 0;
+            double sinSum = 0;
+            for (int i = 0; i < particleCount; i++)
+            {
+                x += particleWeight[i] * particleX[i];
+                y += particleWeight[i] * particleY[i];
+                cosSum += particleWeight[i] * std::cos(particleRotation[i]);
+                sinSum += particleWeight[i] * std::sin(particleRotation[i]);
+            }
+            return Pose(x, y, std::atan2(sinSum, cosSum));
+        }
+
+        /**
+         * Gets the spread of the particles' positions around their mean.
+         * @return The standard deviation of the position in inches.
+         */
+        double getPositionError()
+        {
+            Pose estimate = getEstimate();
+            double variance = 0;
+            for (int i = 0; i < particleCount; i++)
+            {
+                double errorX = particleX[i] - estimate.x;
+                double errorY = particleY[i] - estimate.y;
+                variance += particleWeight[i] * (errorX * errorX + errorY * errorY);
+            }
+            return std::sqrt(variance);
+        }
+
+        /**
+         * Gets the number of particles that effectively carry the weight.
+         * Equal to the particle count when all weights are equal, and 1 when a single particle has all of it.
+         * @return The effective number of particles.
+         */
+        double getEffectiveParticleCount()
+        {
+            double sumSquared = 0;
+            for (int i = 0; i < particleCount; i++)
+                sumSquared += particleWeight[i] * particleWeight[i];
+            return sumSquared > 0 ? 1.0 / sumSquared : 0;
+        }
+
+        /**
+         * Gets the number of particles.
+         * @return The number of particles.
+         */
+        int getParticleCount()
+        {
+            return particleCount;
+        }
+
+        /**
+         * Gets a single particle.
+         * @param index The index of the particle.
+         * @return The pose of the particle.
+         */
+        Pose getParticle(int index)
+        {
+            return Pose(particleX[index], particleY[index], particleRotation[index]);
+        }
+
+        /**
+         * Uses an occupancy grid of the field for distance measurements.
+         * Uses the same layout as `PathFinder`: a 144in field centered on the origin, with cells outside the grid occupied.
+         * The grid should mark the walls and field elements as they are, without the padding added for path planning.
+         * @param occupancyGrid The occupancy grid of the field.
+         */
+        void useOccupancyGrid(OccupancyGrid &occupancyGrid)
+        {
+            this->occupancyGrid = &occupancyGrid;
+        }
+
+        /**
+         * Sets the noise added to each particle as it moves.
+         * @param translationNoise The standard deviation of the translation per inch travelled.
+         * @param rotationNoise The standard deviation of the rotation per radian turned.
+         * @param rotationFromTranslationNoise The standard deviation of the rotation in radians per inch travelled.
+         */
+        void setMotionNoise(double translationNoise, double rotationNoise, double rotationFromTranslationNoise)
+        {
+            this->translationNoise = translationNoise;
+            this->rotationNoise = rotationNoise;
+            this->rotationFromTranslationNoise = rotationFromTranslationNoise;
+        }
+
+        /**
+         * Casts a ray through the occupancy grid, one cell boundary at a time.
+         * @param x The x position of the ray's origin in inches.
+         * @param y The y position of the ray's origin in inches.
+         * @param angle The direction of the ray in radians.
+         * @param maxDistance The maximum distance to cast in inches.
+         * @return The distance to the first occupied cell in inches, or `maxDistance` if none was hit.
+         */
+        double _raycast(double x, double y, double angle, double maxDistance)
+        {
+            // Field Pose >> Cell Pose
+            double cellWidth = FIELD_WIDTH / (double)occupancyGrid->width;
+            double cellHeight = FIELD_HEIGHT / (double)occupancyGrid->height;
+            double cellPositionX = (x + FIELD_WIDTH * 0.5) / cellWidth;
+            double cellPositionY = (y + FIELD_HEIGHT * 0.5) / cellHeight;
+            int cellX = (int)std::floor(cellPositionX);
+            int cellY = (int)std::floor(cellPositionY);
+            if (occupancyGrid->getOccupied(cellX, cellY))
+                return 0;
+
+            // Distance along the ray to cross one cell, and to the first boundary, on each axis
+            double directionX = std::cos(angle);
+            double directionY = std::sin(angle);
+            int stepX = directionX > 0 ? 1 : -1;
+            int stepY = directionY > 0 ? 1 : -1;
+            double crossX = directionX != 0 ? std::abs(cellWidth / directionX) : INFINITY;
+            double crossY = directionY != 0 ? std::abs(cellHeight / directionY) : INFINITY;
+            double boundaryX = directionX != 0 ? crossX * (directionX > 0 ? cellX + 1 - cellPositionX : cellPositionX - cellX) : INFINITY;
+            double boundaryY = directionY != 0 ? crossY * (directionY > 0 ? cellY + 1 - cellPositionY : cellPositionY - cellY) : INFINITY;
+
+            while (true)
+            {
+                double distance;
+                if (boundaryX < boundaryY)
+                {
+                    distance = boundaryX;
+                    cellX += stepX;
+                    boundaryX += crossX;
+                }
+                else
+                {
+                    distance = boundaryY;
+                    cellY += stepY;
+                    boundaryY += crossY;
+                }
+
+                if (distance >= maxDistance)
+                    return maxDistance;
+                if (occupancyGrid->getOccupied(cellX, cellY))
+                    return distance;
+            }
+        }
+
+        /**
+         * Scales the weights to sum to 1.
+         * If every particle was ruled out, the measurement is assumed to be wrong and the weights are reset to equal.
+         */
+        void _normalize()
+        {
+            double totalWeight = 0;
+            for (int i = 0; i < particleCount; i++)
+                totalWeight += particleWeight[i];
+
+            double scale = totalWeight > 0 && std::isfinite(totalWeight) ? 1.0 / totalWeight : 0;
+            for (int i = 0; i < particleCount; i++)
+                particleWeight[i] = scale > 0 ? particleWeight[i] * scale : 1.0 / particleCount;
+        }
+
+    private:
+        static constexpr double FIELD_WIDTH = 144.0;                             // in
+        static constexpr double FIELD_HEIGHT = 144.0;                            // in
+        static constexpr double RESAMPLE_THRESHOLD = 0.5;                        // % of particles
+        static constexpr double UNMODELED_PROBABILITY = 0.05;                    // %
+        static constexpr double DEFAULT_TRANSLATION_NOISE = 0.05;                // in/in
+        static constexpr double DEFAULT_ROTATION_NOISE = 0.05;                   // rad/rad
+        static constexpr double DEFAULT_ROTATION_FROM_TRANSLATION_NOISE = 0.002; // rad/in
+
+        const int particleCount;
+        std::mt19937 random;
+        std::normal_distribution<double> normal = std::normal_distribution<double>(0, 1);
+        OccupancyGrid *occupancyGrid = nullptr;
+
+        double translationNoise = DEFAULT_TRANSLATION_NOISE;
+        double rotationNoise = DEFAULT_ROTATION_NOISE;
+        double rotationFromTranslationNoise = DEFAULT_ROTATION_FROM_TRANSLATION_NOISE;
+
+        // Particles
+        std::vector<double> particleX;        // in
+        std::vector<double> particleY;        // in
+        std::vector<double> particleRotation; // rad
+        std::vector<double> particleWeight;
+
+        // Resampling Buffers
+        std::vector<double> resampleX;
+        std::vector<double> resampleY;
+        std::vector<double> resampleRotation;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "../geometry/pose.hpp"
+#include "../geometry/units.hpp"
+#include <array>
+#include <cstdint>
+
+namespace devils
+{
+    /**
+     * Represents a timestamped pose and velocity recorded by odometry.
+     */
+    struct PoseSample
+    {
+        /// @brief The time the sample was measured in milliseconds.
+        uint32_t timestamp = 0;
+        /// @brief The x position of the robot in inches.
+        double x = 0;
+        /// @brief The y position of the robot in inches.
+        double y = 0;
+        /// @brief The rotation of the robot in radians.
+        double rotation = 0;
+        /// @brief The x velocity of the robot in inches per second.
+        double velocityX = 0;
+        /// @brief The y velocity of the robot in inches per second.
+        double velocityY = 0;
+        /// @brief The angular velocity of the robot in radians per second.
+        double velocityRotation = 0;
+        /// @brief The estimated position error in inches, or 0 if the source does not estimate it.
+        double positionError = 0;
+
+        /**
+         * Gets the position of the sample as a pose.
+         * @return The pose of the sample.
+         */
+        Pose getPose()
+        {
+            return Pose(x, y, rotation);
+        }
+
+        /**
+         * Gets the velocity of the sample as a pose.
+         * @return The velocity of the sample in inches and radians per second.
+         */
+        Pose getVelocity()
+        {
+            return Pose(velocityX, velocityY, velocityRotation);
+        }
+    };
+
+    /**
+     * Stores the most recent odometry samples in a fixed-size ring buffer.
+     * Used to look up where the robot was when a delayed measurement (GPS, vision) was captured.
+     */
+    class PoseHistory
+    {
+    public:
+        /// @brief The number of samples kept. 128 samples is 1.28s of history at 10ms.
+        static constexpr int CAPACITY = 128;
+
+        /**
+         * Records a new sample, overwriting the oldest sample once full.
+         * Samples must be recorded in time order.
+         * @param sample The sample to record.
+         */
+        void record(PoseSample sample)
+        {
+            mutex.take();
+            head = (head + 1) % CAPACITY;
+            samples[head] = sample;
+            if (size < CAPACITY)
+                size++;
+            mutex.give();
+        }
+
+        /**
+         * Removes all samples. Should be called when the pose is reset.
+         */
+        void clear()
+        {
+            mutex.take();
+            size = 0;
+            mutex.give();
+        }
+
+        /**
+         * Gets the sample at a timestamp, interpolating between the samples on either side.
+         * Timestamps outside of the history are clamped to the oldest or newest sample.
+         * @param timestamp The time to look up in milliseconds.
+         * @return The interpolated sample, or an empty sample if the history is empty.
+         */
+        PoseSample getSampleAt(uint32_t timestamp)
+        {
+            mutex.take();
+            PoseSample result = _getSampleAt(timestamp);
+            mutex.give();
+            return result;
+        }
+
+        /**
+         * Gets the pose at a timestamp, interpolating between the samples on either side.
+         * @param timestamp The time to look up in milliseconds.
+         * @return The interpolated pose.
+         */
+        Pose getPoseAt(uint32_t timestamp)
+        {
+            return getSampleAt(timestamp).getPose();
+        }
+
+        /**
+         * Gets the number of samples in the history.
+         * @return The number of samples.
+         */
+        int getSize()
+        {
+            return size;
+        }
+
+    private:
+        /**
+         * Gets the sample at a timestamp. The mutex must be held.
+         * @param timestamp The time to look up in milliseconds.
+         * @return The interpolated sample.
+         */
+        PoseSample _getSampleAt(uint32_t timestamp)
+        {
+            if (size == 0)
+                return PoseSample();
+
+            // Newest
+            PoseSample &newest = samples[head];
+            if ((int32_t)(timestamp - newest.timestamp) >= 0)
+                return newest;
+
+            // Walk back from the newest sample
+            PoseSample *after = &newest;
+            for (int i = 1; i < size; i++)
+            {
+                PoseSample &before = samples[(head - i + CAPACITY) % CAPACITY];
+                if ((int32_t)(timestamp - before.timestamp) >= 0)
+                    return _interpolate(before, *after, timestamp);
+                after = &before;
+            }
+
+            // Oldest
+            return *after;
+        }
+
+        /**
+         * Linearly interpolates between two samples.
+         * @param before The sample before the timestamp.
+         * @param after The sample after the timestamp.
+         * @param timestamp The time to interpolate to in milliseconds.
+         * @return The interpolated sample.
+         */
+        static PoseSample _interpolate(PoseSample &before, PoseSample &after, uint32_t timestamp)
+        {
+            uint32_t deltaT = after.timestamp - before.timestamp;
+            double t = deltaT > 0 ? (double)(timestamp - before.timestamp) / deltaT : 0;
+
+            PoseSample result;
+            result.timestamp = timestamp;
+            result.x = before.x + (after.x - before.x) * t;
+            result.y = before.y + (after.y - before.y) * t;
+            result.rotation = before.rotation + Units::diffRad(after.rotation, before.rotation) * t;
+            result.velocityX = before.velocityX + (after.velocityX - before.velocityX) * t;
+            result.velocityY = before.velocityY + (after.velocityY - before.velocityY) * t;
+            result.velocityRotation = before.velocityRotation + (after.velocityRotation - before.velocityRotation) * t;
+            result.positionError = before.positionError + (after.positionError - before.positionError) * t;
+            return result;
+        }
+
+        std::array<PoseSample, CAPACITY> samples;
+        int head = -1;
+        int size = 0;
+        pros::Mutex mutex;
+    };
+}
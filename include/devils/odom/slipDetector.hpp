@@ -0,0 +1,197 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "odomSource.hpp"
+#include "../hardware/imu.hpp"
+#include "../geometry/vector3.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/profiler.hpp"
+#include "../utils/runnable.hpp"
+#include <atomic>
+#include <cmath>
+
+namespace devils
+{
+    /**
+     * Detects wheel slip and collisions by comparing the acceleration measured by the IMU
+     * with the acceleration implied by the wheel odometry.
+     *
+     * While the wheels grip, both agree. Spinning wheels accelerate without the IMU feeling it,
+     * and a push or a hit is felt by the IMU without the wheels seeing it.
+     * Only the planar magnitudes are compared, so the IMU can be mounted in any orientation as long as it is level.
+     * Should be run at the same period as the wheel odometry.
+     */
+    class SlipDetector : public Runnable
+    {
+    public:
+        /**
+         * Creates a new slip detector.
+         * @param imu The IMU to measure the robot's acceleration with.
+         * @param wheelOdom The wheel odometry to compare against.
+         */
+        SlipDetector(IMU &imu, OdomSource &wheelOdom)
+            : imu(imu),
+              wheelOdom(wheelOdom)
+        {
+        }
+
+        void update() override
+        {
+            ScopedTimer timer(updateProfile);
+
+            // Only differentiate new wheel samples
+            PoseSample sample = wheelOdom.getSnapshot();
+            if (sample.timestamp == 0 || sample.timestamp == lastSample.timestamp)
+                return;
+            bool hasLastSample = lastSample.timestamp != 0;
+            PoseSample lastWheelSample = lastSample;
+            lastSample = sample;
+            if (!hasLastSample || sample.timestamp < lastWheelSample.timestamp)
+                return;
+
+            // Wheel Acceleration
+            // Tangential from the change in speed, centripetal from turning at that speed
+            double deltaT = (sample.timestamp - lastWheelSample.timestamp) / 1000.0;
+            double speed = _getForwardSpeed(sample);
+            double tangentialAccel = (speed - _getForwardSpeed(lastWheelSample)) / deltaT;
+            double centripetalAccel = speed * sample.velocityRotation;
+            double rawWheelAccel = std::hypot(tangentialAccel, centripetalAccel);
+            wheelAccel += (rawWheelAccel - wheelAccel) * ACCEL_FILTER_GAIN;
+
+            // IMU Acceleration
+            Vector3 accel = imu.getAccel();
+            double rawIMUAccel = std::hypot(accel.x, accel.y);
+            imuAccel += (rawIMUAccel - imuAccel) * ACCEL_FILTER_GAIN;
+
+            _updateImpact(rawIMUAccel - wheelAccel, sample.timestamp);
+            _updateSlip(std::abs(wheelAccel - imuAccel), sample.timestamp);
+        }
+
+        /**
+         * Flags an impact when the IMU feels a sudden jolt the wheels did not cause.
+         * Uses the unfiltered IMU acceleration, since impacts only last a few samples.
+         * @param unexplainedAccel The IMU acceleration not explained by the wheels in in/s^2.
+         * @param timestamp The time of the sample in milliseconds.
+         */
+        void _updateImpact(double unexplainedAccel, uint32_t timestamp)
+        {
+            if (unexplainedAccel < impactAccel)
+                return;
+            if (impactCount > 0 && timestamp - lastImpactTimestamp < IMPACT_COOLDOWN)
+                return;
+
+            lastImpactTimestamp = timestamp;
+            impactCount++;
+            hasImpact = true;
+            Logger::warn("SlipDetector: Impact of " + std::to_string(unexplainedAccel) + "in/s^2");
+        }
+
+        /**
+         * Flags slip while the wheel and IMU accelerations disagree for several samples in a row.
+         * The flag is held for a short time after they agree again, since the wheel pose is
+         * still off by whatever distance slipped.
+         * @param accelError The difference between the wheel and IMU accelerations in in/s^2.
+         * @param timestamp The time of the sample in milliseconds.
+         */
+        void _updateSlip(double accelError, uint32_t timestamp)
+        {
+            if (accelError > slipAccel)
+                slipSamples++;
+            else
+                slipSamples = 0;
+
+            if (slipSamples >= SLIP_SAMPLES || (impactCount > 0 && timestamp - lastImpactTimestamp < SLIP_HOLD_TIME))
+                lastSlipTimestamp = timestamp;
+
+            bool wasSlipping = isSlippingFlag;
+            isSlippingFlag = lastSlipTimestamp != 0 && timestamp - lastSlipTimestamp < SLIP_HOLD_TIME;
+            if (isSlippingFlag && !wasSlipping)
+                Logger::debug("SlipDetector: Wheels slipping");
+        }
+
+        /**
+         * Gets the speed of a sample along its heading.
+         * @param sample The sample to get the speed of.
+         * @return The forward speed in inches per second.
+         */
+        static double _getForwardSpeed(PoseSample &sample)
+        {
+            return sample.velocityX * std::cos(sample.rotation) + sample.velocityY * std::sin(sample.rotation);
+        }
+
+        /**
+         * Checks if the wheels are slipping, or were hit recently.
+         * Wheel odometry should be trusted less while this is true.
+         * @return True if the wheels are slipping, false otherwise.
+         */
+        bool isSlipping()
+        {
+            return isSlippingFlag;
+        }
+
+        /**
+         * Checks for an impact since the last call, then clears it.
+         * Meant to be polled by a single autonomous loop so it can react once per impact.
+         * @return True if the robot was hit since the last call, false otherwise.
+         */
+        bool consumeImpact()
+        {
+            return hasImpact.exchange(false);
+        }
+
+        /**
+         * Gets the number of impacts since the detector was created.
+         * @return The number of impacts.
+         */
+        int getImpactCount()
+        {
+            return impactCount;
+        }
+
+        /**
+         * Gets the time of the last impact.
+         * @return The time of the last impact in milliseconds, from `pros::millis()`.
+         */
+        uint32_t getLastImpactTimestamp()
+        {
+            return lastImpactTimestamp;
+        }
+
+        /**
+         * Sets the acceleration thresholds of the detector.
+         * @param slipAccel The difference between the wheel and IMU accelerations that counts as slip in in/s^2.
+         * @param impactAccel The IMU acceleration not explained by the wheels that counts as an impact in in/s^2.
+         */
+        void setThresholds(double slipAccel, double impactAccel)
+        {
+            this->slipAccel = slipAccel;
+            this->impactAccel = impactAccel;
+        }
+
+    private:
+        inline static ProfileSite updateProfile = ProfileSite("SlipDetector.update");
+
+        static constexpr double ACCEL_FILTER_GAIN = 0.3;      // %
+        static constexpr double DEFAULT_SLIP_ACCEL = 100.0;   // in/s^2
+        static constexpr double DEFAULT_IMPACT_ACCEL = 400.0; // in/s^2
+        static constexpr int SLIP_SAMPLES = 3;                // samples
+        static constexpr uint32_t SLIP_HOLD_TIME = 250;       // ms
+        static constexpr uint32_t IMPACT_COOLDOWN = 500;      // ms
+
+        IMU &imu;
+        OdomSource &wheelOdom;
+
+        double slipAccel = DEFAULT_SLIP_ACCEL;     // in/s^2
+        double impactAccel = DEFAULT_IMPACT_ACCEL; // in/s^2
+
+        PoseSample lastSample;
+        double wheelAccel = 0; // in/s^2
+        double imuAccel = 0;   // in/s^2
+        int slipSamples = 0;
+        uint32_t lastSlipTimestamp = 0;
+        std::atomic<bool> isSlippingFlag = false;
+
+        std::atomic<bool> hasImpact = false;
+        std::atomic<int> impactCount = 0;
+        std::atomic<uint32_t> lastImpactTimestamp = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,346 @@
+#pragma once
+#include "../chassis/chassis.hpp"
+#include "../hardware/imu.hpp"
+#include "../hardware/rotationSensor.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/profiler.hpp"
+#include "../utils/runnable.hpp"
+#include "../utils/seqLock.hpp"
+#include "../geometry/pose.hpp"
+#include "../geometry/units.hpp"
+#include "odomSource.hpp"
+#include "poseHistory.hpp"
+#include "pros/rtos.hpp"
+#include "pros/error.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+
+namespace devils
+{
+    /**
+     * Represents an odometry system using two parallel tracking wheels and one perpendicular tracking wheel.
+     * Heading is measured by the parallel wheels, so it updates as fast as the odometry runs.
+     * An IMU can optionally be blended in to correct slow drift in the wheel heading.
+     */
+    class ThreeWheelOdometry : public OdomSource, public Runnable
+    {
+    public:
+        /**
+         * Creates a new three wheel odometry system.
+         * Offsets are measured from the robot's center of rotation. Use `calibrate` to measure them.
+         * @param leftSensor The left parallel tracking wheel. Should read positive when driving forward.
+         * @param rightSensor The right parallel tracking wheel. Should read positive when driving forward.
+         * @param perpendicularSensor The perpendicular tracking wheel. Should read positive when moving right.
+         * @param wheelRadius The radius of the tracking wheels in inches.
+         * @param leftOffset The distance from the center of rotation to the left wheel in inches.
+         * @param rightOffset The distance from the center of rotation to the right wheel in inches.
+         * @param perpendicularOffset The distance from the center of rotation to the perpendicular wheel in inches.
+         *                            Positive if the wheel is behind the center of rotation.
+         */
+        ThreeWheelOdometry(RotationSensor &leftSensor,
+                           RotationSensor &rightSensor,
+                           RotationSensor &perpendicularSensor,
+                           const double wheelRadius,
+                           double leftOffset,
+                           double rightOffset,
+                           double perpendicularOffset)
+            : leftSensor(leftSensor),
+              rightSensor(rightSensor),
+              perpendicularSensor(perpendicularSensor),
+              wheelRadius(wheelRadius)
+        {
+            setOffsets(leftOffset, rightOffset, perpendicularOffset);
+            lastUpdateTimestamp = pros::millis();
+        }
+
+        void update() override
+        {
+            ScopedTimer timer(updateProfile);
+
+            _applyPendingPose();
+
+            // Get Delta Time
+            uint32_t now = pros::millis();
+            uint32_t deltaT = now - lastUpdateTimestamp;
+            lastUpdateTimestamp = now;
+            Pose lastPose = currentPose;
+
+            // Get Delta Distance
+            double left = _getDistance(leftSensor);
+            double right = _getDistance(rightSensor);
+            double perpendicular = _getDistance(perpendicularSensor);
+            double deltaLeft = left - lastLeft;
+            double deltaRight = right - lastRight;
+            double deltaPerpendicular = perpendicular - lastPerpendicular;
+            lastLeft = left;
+            lastRight = right;
+            lastPerpendicular = perpendicular;
+
+            // Remove the motion of each wheel caused by rotation
+            double deltaRotation = (deltaLeft - deltaRight) / (leftOffset + rightOffset);
+            double deltaForward = (deltaLeft * rightOffset + deltaRight * leftOffset) / (leftOffset + rightOffset);
+            double deltaLateral = deltaPerpendicular + perpendicularOffset * deltaRotation;
+
+            // Update X, Y, and Rotation
+            currentPose = currentPose.integrateArc(deltaForward, deltaLateral, deltaRotation);
+            _updateIMU();
+
+            // Update Velocity
+            if (deltaT > 0)
+            {
+                double velocityX = (currentPose.x - lastPose.x) * 1000.0 / deltaT;
+                double velocityY = (currentPose.y - lastPose.y) * 1000.0 / deltaT;
+                double velocityRotation = Units::diffRad(currentPose.rotation, lastPose.rotation) * 1000.0 / deltaT;
+                currentVelocity.x += (velocityX - currentVelocity.x) * VELOCITY_FILTER_GAIN;
+                currentVelocity.y += (velocityY - currentVelocity.y) * VELOCITY_FILTER_GAIN;
+                currentVelocity.rotation += (velocityRotation - currentVelocity.rotation) * VELOCITY_FILTER_GAIN;
+            }
+
+            // Publish
+            PoseSample sample = PoseSample{now,
+                                           currentPose.x, currentPose.y, currentPose.rotation,
+                                           currentVelocity.x, currentVelocity.y, currentVelocity.rotation};
+            history.record(sample);
+            snapshot.write(sample);
+        }
+
+        /**
+         * Blends the IMU heading into the wheel heading, if an IMU was given in `useIMU`.
+         */
+        void _updateIMU()
+        {
+            if (imu == nullptr || imuWeight <= 0)
+                return;
+            double heading = imu->getHeading();
+            if (heading != PROS_ERR_F)
+                currentPose.rotation += Units::diffRad(heading, currentPose.rotation) * imuWeight;
+        }
+
+        /**
+         * Blends an IMU into the heading measured by the wheels.
+         * @param imu The IMU to use.
+         * @param weight The fraction of the difference to the IMU heading to correct each update, from 0 to 1.
+         */
+        void useIMU(IMU &imu, double weight = DEFAULT_IMU_WEIGHT)
+        {
+            this->imu = &imu;
+            this->imuWeight = weight;
+        }
+
+        /**
+         * Sets the distance of each tracking wheel from the robot's center of rotation.
+         * @param leftOffset The distance from the center of rotation to the left wheel in inches.
+         * @param rightOffset The distance from the center of rotation to the right wheel in inches.
+         * @param perpendicularOffset The distance from the center of rotation to the perpendicular wheel in inches.
+         *                            Positive if the wheel is behind the center of rotation.
+         */
+        void setOffsets(double leftOffset, double rightOffset, double perpendicularOffset)
+        {
+            if (leftOffset + rightOffset <= 0)
+            {
+                Logger::error("ThreeWheelOdometry: parallel wheels must be a positive distance apart");
+                return;
+            }
+            this->leftOffset = leftOffset;
+            this->rightOffset = rightOffset;
+            this->perpendicularOffset = perpendicularOffset;
+        }
+
+        /**
+         * Measures the tracking wheel offsets by turning in place and comparing each wheel to the IMU.
+         * Blocks until the robot finishes turning. The robot should have room to turn and the IMU should be calibrated.
+         * Call `setPose` afterwards, since the pose is not kept during calibration.
+         * @param chassis The chassis to turn with.
+         * @param imu The IMU to measure the rotation with.
+         * @param turns The number of full turns to make. More turns average out more wheel slip.
+         * @param speed The speed to turn at, from 0 to 1.
+         * @return True if the offsets were measured and applied, false otherwise.
+         */
+        bool calibrate(BaseChassis &chassis, IMU &imu, int turns = CALIBRATION_TURNS, double speed = CALIBRATION_SPEED)
+        {
+            double lastHeading = imu.getHeading();
+            if (lastHeading == PROS_ERR_F)
+            {
+                Logger::error("ThreeWheelOdometry: calibration needs a working IMU");
+                return false;
+            }
+
+            double startLeft = _getDistance(leftSensor);
+            double startRight = _getDistance(rightSensor);
+            double startPerpendicular = _getDistance(perpendicularSensor);
+
+            // Turn
+            double totalRotation = 0;
+            uint32_t startTime = pros::millis();
+            uint32_t stopTime = 0;
+            chassis.move(0, speed);
+            while (stopTime == 0 || pros::millis() - stopTime < CALIBRATION_SETTLE_TIME)
+            {
+                pros::delay(CALIBRATION_PERIOD);
+
+                double heading = imu.getHeading();
+                if (heading != PROS_ERR_F)
+                {
+                    totalRotation += Units::diffRad(heading, lastHeading);
+                    lastHeading = heading;
+                }
+
+                // Keep measuring while the robot coasts to a stop
+                if (stopTime == 0 && std::abs(totalRotation) >= turns * 2 * M_PI)
+                {
+                    chassis.stop();
+                    stopTime = pros::millis();
+                }
+                if (stopTime == 0 && pros::millis() - startTime > CALIBRATION_TIMEOUT)
+                {
+                    chassis.stop();
+                    Logger::error("ThreeWheelOdometry: calibration timed out");
+                    return false;
+                }
+            }
+
+            // In a turn in place, each wheel travels its offset times the rotation
+            double deltaLeft = _getDistance(leftSensor) - startLeft;
+            double deltaRight = _getDistance(rightSensor) - startRight;
+            double deltaPerpendicular = _getDistance(perpendicularSensor) - startPerpendicular;
+            double measuredLeftOffset = deltaLeft / totalRotation;
+            double measuredRightOffset = -deltaRight / totalRotation;
+            double measuredPerpendicularOffset = -deltaPerpendicular / totalRotation;
+
+            if (measuredLeftOffset <= 0 || measuredRightOffset <= 0)
+            {
+                Logger::error("ThreeWheelOdometry: calibration measured a negative offset, check the wheel directions");
+                return false;
+            }
+
+            char buffer[128];
+            snprintf(buffer, sizeof(buffer), "ThreeWheelOdometry: calibrated offsets L %.3f R %.3f P %.3f",
+                     measuredLeftOffset, measuredRightOffset, measuredPerpendicularOffset);
+            Logger::info(buffer);
+
+            setOffsets(measuredLeftOffset, measuredRightOffset, measuredPerpendicularOffset);
+            return true;
+        }
+
+        /**
+         * Gets the current pose of the robot.
+         */
+        Pose &getPose() override
+        {
+            return currentPose;
+        }
+
+        /**
+         * Sets the current pose of the robot.
+         * The pose is applied by the odometry task on its next update, so it is safe to call from any task.
+         * @param pose The pose to set the robot to.
+         */
+        void setPose(Pose &pose) override
+        {
+            pendingPoseMutex.take();
+            pendingPose = pose;
+            hasPendingPose = true;
+            pendingPoseMutex.give();
+        }
+
+        /**
+         * Applies a pose from `setPose`. Called from the odometry task.
+         */
+        void _applyPendingPose()
+        {
+            if (!hasPendingPose)
+                return;
+
+            pendingPoseMutex.take();
+            currentPose = pendingPose;
+            hasPendingPose = false;
+            pendingPoseMutex.give();
+
+            currentVelocity = Pose();
+            history.clear();
+            if (imu != nullptr)
+                imu->setHeading(currentPose.rotation);
+        }
+
+        /**
+         * Gets the latest pose published by the odometry task.
+         * Falls back to `getPose()` before the first update.
+         * @return The latest pose and velocity of the robot.
+         */
+        PoseSample getSnapshot() override
+        {
+            PoseSample sample = snapshot.read();
+            if (sample.timestamp == 0)
+                return _getPoseSnapshot();
+            return sample;
+        }
+
+        /**
+         * Gets the velocity of the robot in field coordinates.
+         * @return The velocity in inches per second, with `rotation` in radians per second.
+         */
+        Pose getVelocity() override
+        {
+            return currentVelocity;
+        }
+
+        /**
+         * Gets the pose of the robot at a past time, interpolated from the pose history.
+         * @param timestamp The time to look up in milliseconds, from `pros::millis()`.
+         * @return The pose of the robot at the timestamp.
+         */
+        Pose getPoseAt(uint32_t timestamp) override
+        {
+            if (history.getSize() == 0)
+                return currentPose;
+            return history.getPoseAt(timestamp);
+        }
+
+    private:
+        /**
+         * Gets the distance travelled by a tracking wheel.
+         * @param sensor The tracking wheel's rotation sensor.
+         * @return The distance travelled in inches.
+         */
+        double _getDistance(RotationSensor &sensor)
+        {
+            return sensor.getAngle() * wheelRadius;
+        }
+
+        inline static ProfileSite updateProfile = ProfileSite("ThreeWheelOdometry.update");
+
+        static constexpr double VELOCITY_FILTER_GAIN = 0.5;      // %
+        static constexpr double DEFAULT_IMU_WEIGHT = 0.02;       // %
+        static constexpr int CALIBRATION_TURNS = 5;              // turns
+        static constexpr double CALIBRATION_SPEED = 0.4;         // %
+        static constexpr uint32_t CALIBRATION_PERIOD = 10;       // ms
+        static constexpr uint32_t CALIBRATION_SETTLE_TIME = 500; // ms
+        static constexpr uint32_t CALIBRATION_TIMEOUT = 30000;   // ms
+
+        RotationSensor &leftSensor;
+        RotationSensor &rightSensor;
+        RotationSensor &perpendicularSensor;
+        const double wheelRadius;
+        double leftOffset = 1;
+        double rightOffset = 1;
+        double perpendicularOffset = 0;
+
+        Pose currentPose = Pose();
+        Pose currentVelocity = Pose();
+        PoseHistory history;
+        SeqLock<PoseSample> snapshot;
+        Pose pendingPose = Pose();
+        std::atomic<bool> hasPendingPose = false;
+        pros::Mutex pendingPoseMutex;
+        uint32_t lastUpdateTimestamp = 0;
+
+        double lastLeft = 0;
+        double lastRight = 0;
+        double lastPerpendicular = 0;
+
+        // IMU
+        IMU *imu = nullptr;
+        double imuWeight = 0;
+    };
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "../hardware/rotationSensor.hpp"
 #include "../utils/logger.hpp"
 #include "../geometry/pose.hpp"
+#include "../geometry/units.hpp"
 #include "odomSource.hpp"
 #include "pros/rtos.hpp"
 #include "pros/error.h"
@@ -51,20 +52,17 @@ namespace devils
             lastVertical = vertical;
             lastHorizontal = horizontal;
 
-            // Run Computationally Expensive Trig Functions
-            double sinTheta = std::sin(currentPose.rotation);
-            double cosTheta = std::cos(currentPose.rotation);
-
-            // Calculate Delta X and Y
-            double deltaX = deltaVertical * cosTheta + deltaHorizontal * sinTheta;
-            double deltaY = deltaVertical * sinTheta - deltaHorizontal * cosTheta;
+            // Get Delta Rotation from the IMU
+            double imuHeading = imu != nullptr ? imu->getHeading() : PROS_ERR_F;
+            double deltaRotation = 0;
+            if (imuHeading != PROS_ERR_F)
+                deltaRotation = Units::diffRad(imuHeading, currentPose.rotation);
 
             // Update X, Y, and Rotation
-            currentPose.x += deltaX;
-            currentPose.y += deltaY;
-
-            // Update IMU
-            _updateIMU();
+            // The horizontal wheel measures to the left, opposite of `integrateArc`
+            currentPose = currentPose.integrateArc(deltaVertical, -deltaHorizontal, deltaRotation);
+            if (imuHeading != PROS_ERR_F)
+                currentPose.rotation = imuHeading;
         }
 
         /**
@@ -79,19 +77,6 @@ namespace devils
             update(vertical, horizontal);
         }
 
-        /**
-         * Updates the rotation from an IMU specified in `useIMU`.
-         */
-        void _updateIMU()
-        {
-            if (imu == nullptr)
-                return;
-
-            double imuHeading = imu->getHeading();
-            if (imuHeading != PROS_ERR_F)
-                currentPose.rotation = imuHeading;
-        }
-
         /**
          * Enables the IMU for the odometry.
          * @param imu The IMU to use.
@@ -34,17 +34,28 @@ namespace devils
          */
         Pose &getPose() override
         {
-            Pose &gpsPose = odomSource.getPose();
-            double newX = std::cos(rotationOffset) * gpsPose.x + std::sin(rotationOffset) * gpsPose.y;
-            double newY = std::cos(rotationOffset) * gpsPose.y + std::sin(rotationOffset) * gpsPose.x;
-
-            currentPose.x = newX;
-            currentPose.y = newY;
-            currentPose.rotation = Units::normalizeRadians(gpsPose.rotation + rotationOffset);
-
+            currentPose = _transform(odomSource.getPose());
             return currentPose;
         }
 
+        /**
+         * Gets the latest snapshot of the source, transformed.
+         * Keeps the source's timestamp and error estimate.
+         * @return The latest transformed pose and velocity of the robot.
+         */
+        PoseSample getSnapshot() override
+        {
+            PoseSample sample = odomSource.getSnapshot();
+            Pose pose = _transform(sample.getPose());
+            Pose velocity = _transform(sample.getVelocity());
+            sample.x = pose.x;
+            sample.y = pose.y;
+            sample.rotation = pose.rotation;
+            sample.velocityX = velocity.x;
+            sample.velocityY = velocity.y;
+            return sample;
+        }
+
         /**
          * Sets the current pose of the robot.
          * @param pose The pose to set the robot to.
@@ -72,6 +83,18 @@ namespace devils
         }
 
     private:
+        /**
+         * Transforms a pose from the source.
+         * @param pose The pose from the source.
+         * @return The transformed pose.
+         */
+        Pose _transform(Pose pose)
+        {
+            double newX = std::cos(rotationOffset) * pose.x + std::sin(rotationOffset) * pose.y;
+            double newY = std::cos(rotationOffset) * pose.y + std::sin(rotationOffset) * pose.x;
+            return Pose(newX, newY, Units::normalizeRadians(pose.rotation + rotationOffset));
+        }
+
         Pose currentPose = Pose();
         OdomSource &odomSource;
 
@@ -0,0 +1,547 @@
+#pragma once
+#ifndef UKF_SINGLE_PRECISION
+#define UKF_DOUBLE_PRECISION
+#endif
+#include "Eigen/Dense"
+#include "ukf/Core.h"
+#include "ukf/MeasurementVector.h"
+#include "pros/rtos.hpp"
+#include "pros/error.h"
+#include "odomSource.hpp"
+#include "poseHistory.hpp"
+#include "../hardware/imu.hpp"
+#include "../geometry/pose.hpp"
+#include "../geometry/units.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/profiler.hpp"
+#include "../utils/runnable.hpp"
+#include "../utils/seqLock.hpp"
+#include <atomic>
+#include <cmath>
+
+namespace devils
+{
+    /// @brief Keys of the `UnscentedKalmanFilterOdom` state fields.
+    enum UkfOdomStateKey
+    {
+        UKF_POSITION,
+        UKF_HEADING,
+        UKF_VELOCITY,
+        UKF_ANGULAR_VELOCITY
+    };
+
+    /// @brief Keys of the `UnscentedKalmanFilterOdom` measurement fields.
+    enum UkfOdomMeasurementKey
+    {
+        UKF_WHEEL_VELOCITY,
+        UKF_IMU_YAW_RATE,
+        UKF_IMU_HEADING,
+        UKF_GPS_POSITION,
+        UKF_GPS_HEADING
+    };
+
+    /// @brief The state of the robot: position in inches, heading in radians, and forward and angular velocity.
+    typedef UKF::StateVector<
+        UKF::Field<UKF_POSITION, UKF::Vector<2>>,
+        UKF::Field<UKF_HEADING, real_t>,
+        UKF::Field<UKF_VELOCITY, real_t>,
+        UKF::Field<UKF_ANGULAR_VELOCITY, real_t>>
+        UkfOdomState;
+
+    /// @brief The sensor readings available on a tick. Only the fields that are set are used.
+    typedef UKF::DynamicMeasurementVector<
+        UKF::Field<UKF_WHEEL_VELOCITY, real_t>,
+        UKF::Field<UKF_IMU_YAW_RATE, real_t>,
+        UKF::Field<UKF_IMU_HEADING, real_t>,
+        UKF::Field<UKF_GPS_POSITION, UKF::Vector<2>>,
+        UKF::Field<UKF_GPS_HEADING, real_t>>
+        UkfOdomMeasurement;
+
+    /**
+     * Moves a tank drive along a constant-curvature arc at its current forward and angular velocity.
+     * Used as the process model of `UnscentedKalmanFilterOdom` in place of a numerical integrator.
+     */
+    struct UkfOdomProcessModel
+    {
+        /**
+         * Predicts the state after a period of time.
+         * @param deltaT The time to predict forward in seconds.
+         * @param state The current state.
+         * @return The predicted state.
+         */
+        static UkfOdomState integrate(real_t deltaT, const UkfOdomState &state)
+        {
+            UKF::Vector<2> position = state.get_field<UKF_POSITION>();
+            real_t heading = state.get_field<UKF_HEADING>();
+            real_t velocity = state.get_field<UKF_VELOCITY>();
+            real_t angularVelocity = state.get_field<UKF_ANGULAR_VELOCITY>();
+            real_t nextHeading = heading + angularVelocity * deltaT;
+
+            // Straight lines have no radius
+            if (std::abs(angularVelocity) < MIN_ANGULAR_VELOCITY)
+            {
+                position(0) += velocity * deltaT * std::cos(heading);
+                position(1) += velocity * deltaT * std::sin(heading);
+            }
+            else
+            {
+                real_t radius = velocity / angularVelocity;
+                position(0) += radius * (std::sin(nextHeading) - std::sin(heading));
+                position(1) += radius * (std::cos(heading) - std::cos(nextHeading));
+            }
+
+            UkfOdomState result = state;
+            result.set_field<UKF_POSITION>(position);
+            result.set_field<UKF_HEADING>(nextHeading);
+            return result;
+        }
+
+    private:
+        static constexpr real_t MIN_ANGULAR_VELOCITY = 1e-6; // rad/s
+    };
+}
+
+namespace UKF
+{
+    template <>
+    template <>
+    inline real_t devils::UkfOdomMeasurement::expected_measurement<devils::UkfOdomState, devils::UKF_WHEEL_VELOCITY>(
+        const devils::UkfOdomState &state)
+    {
+        return state.get_field<devils::UKF_VELOCITY>();
+    }
+
+    template <>
+    template <>
+    inline real_t devils::UkfOdomMeasurement::expected_measurement<devils::UkfOdomState, devils::UKF_IMU_YAW_RATE>(
+        const devils::UkfOdomState &state)
+    {
+        return state.get_field<devils::UKF_ANGULAR_VELOCITY>();
+    }
+
+    template <>
+    template <>
+    inline real_t devils::UkfOdomMeasurement::expected_measurement<devils::UkfOdomState, devils::UKF_IMU_HEADING>(
+        const devils::UkfOdomState &state)
+    {
+        return state.get_field<devils::UKF_HEADING>();
+    }
+
+    template <>
+    template <>
+    inline Vector<2> devils::UkfOdomMeasurement::expected_measurement<devils::UkfOdomState, devils::UKF_GPS_POSITION>(
+        const devils::UkfOdomState &state)
+    {
+        return state.get_field<devils::UKF_POSITION>();
+    }
+
+    template <>
+    template <>
+    inline real_t devils::UkfOdomMeasurement::expected_measurement<devils::UkfOdomState, devils::UKF_GPS_HEADING>(
+        const devils::UkfOdomState &state)
+    {
+        return state.get_field<devils::UKF_HEADING>();
+    }
+}
+
+namespace devils
+{
+    /**
+     * Represents a set of odometry sources fused together using an unscented Kalman filter.
+     *
+     * Unlike `ExtendedKalmanFilterOdom`, the tank model is not linearized. Sigma points are moved along exact arcs,
+     * which avoids linearization error through fast turns at the cost of more CPU time.
+     * The wheel velocity, IMU yaw rate, IMU heading and GPS pose are all measurements of the state.
+     * The wheels do not measure the yaw rate, so without an IMU the heading only comes from the GPS.
+     * Sigma points are stored in fixed-size matrices, so updating the filter never allocates.
+     */
+    class UnscentedKalmanFilterOdom : public OdomSource, public Runnable
+    {
+    public:
+        /// @brief The covariance of the filter state, ordered x, y, heading, velocity and angular velocity.
+        typedef UkfOdomState::CovarianceMatrix Covariance;
+
+        /**
+         * Creates a new fused odometry source using an unscented Kalman filter.
+         * @param wheelOdom The wheel odometry source, used to measure the forward velocity.
+         * @param imu The IMU, used for yaw rate and heading. Can be `nullptr`.
+         * @param gps The absolute odometry source, used to correct the pose. Can be `nullptr`.
+         */
+        UnscentedKalmanFilterOdom(OdomSource *wheelOdom, IMU *imu = nullptr, OdomSource *gps = nullptr)
+            : wheelOdom(wheelOdom),
+              imu(imu),
+              gps(gps)
+        {
+            if (wheelOdom == nullptr)
+                throw std::invalid_argument("Wheel odometry is required");
+            _resetState(Pose());
+            lastUpdateTimestamp = pros::millis();
+        }
+
+        /**
+         * Updates the filter with the latest data from each sensor.
+         */
+        void update() override
+        {
+            ScopedTimer timer(updateProfile);
+
+            _applyPendingPose();
+
+            // Get Delta Time
+            uint32_t now = pros::millis();
+            double deltaT = (now - lastUpdateTimestamp) / 1000.0;
+            lastUpdateTimestamp = now;
+            if (deltaT <= 0)
+                return;
+
+            // Predict
+            filter.process_noise_covariance = processNoise * deltaT;
+            filter.measurement_covariance << wheelVelocityVariance,
+                imuYawRateVariance,
+                imuHeadingVariance,
+                gpsPositionVariance, gpsPositionVariance,
+                gpsHeadingVariance;
+            filter.a_priori_step(deltaT);
+
+            // Measurements
+            // The GPS is measured after the prediction, so its gate compares against the predicted pose
+            UkfOdomMeasurement measurement;
+            _measureWheels(measurement);
+            _measureIMU(measurement);
+            _measureGPS(measurement);
+
+            // Correct
+            if (measurement.size() > 0)
+            {
+                filter.innovation_step(measurement);
+                filter.a_posteriori_step();
+            }
+
+            // Publish
+            UKF::Vector<2> position = filter.state.get_field<UKF_POSITION>();
+            double heading = Units::normalizeRadians(filter.state.get_field<UKF_HEADING>());
+            double velocity = filter.state.get_field<UKF_VELOCITY>();
+            currentPose = Pose(position(0), position(1), heading);
+
+            Estimate estimate;
+            estimate.sample = PoseSample{now,
+                                         position(0), position(1), heading,
+                                         velocity * std::cos(heading),
+                                         velocity * std::sin(heading),
+                                         filter.state.get_field<UKF_ANGULAR_VELOCITY>()};
+            Eigen::Map<Covariance>(estimate.covariance) = filter.covariance;
+            published.write(estimate);
+        }
+
+        /**
+         * Gets the current pose of the robot.
+         * @return The current pose of the robot.
+         */
+        Pose &getPose() override
+        {
+            return currentPose;
+        }
+
+        /**
+         * Sets the current pose of the robot and resets the filter's uncertainty.
+         * The pose is applied by the filter task on its next update, so it is safe to call from any task.
+         * @param pose The pose to set the robot to.
+         */
+        void setPose(Pose &pose) override
+        {
+            pendingPoseMutex.take();
+            pendingPose = pose;
+            hasPendingPose = true;
+            pendingPoseMutex.give();
+
+            wheelOdom->setPose(pose);
+            if (gps != nullptr)
+                gps->setPose(pose);
+        }
+
+        /**
+         * Gets the latest estimate published by `UnscentedKalmanFilterOdom::update`.
+         * Falls back to `getPose()` before the first update.
+         * @return The latest pose and velocity of the robot.
+         */
+        PoseSample getSnapshot() override
+        {
+            PoseSample sample = published.read().sample;
+            if (sample.timestamp == 0)
+                return _getPoseSnapshot();
+            return sample;
+        }
+
+        /**
+         * Gets the velocity of the robot in field coordinates.
+         * @return The velocity in inches per second, with `rotation` in radians per second.
+         */
+        Pose getVelocity() override
+        {
+            return getSnapshot().getVelocity();
+        }
+
+        /**
+         * Gets the covariance of the latest published estimate. Safe to call from any task.
+         * @return The covariance of the latest estimate, in inches and radians.
+         */
+        Covariance getCovariance()
+        {
+            Estimate estimate = published.read();
+            return Eigen::Map<Covariance>(estimate.covariance);
+        }
+
+        /**
+         * Sets the noise of the wheel odometry.
+         * @param velocityStdDev The standard deviation of the wheel velocity in inches per second.
+         */
+        void setWheelNoise(double velocityStdDev)
+        {
+            wheelVelocityVariance = velocityStdDev * velocityStdDev;
+        }
+
+        /**
+         * Sets the noise of the IMU.
+         * @param yawRateStdDev The standard deviation of the yaw rate in radians per second.
+         * @param headingStdDev The standard deviation of the heading in radians.
+         */
+        void setIMUNoise(double yawRateStdDev, double headingStdDev)
+        {
+            imuYawRateVariance = yawRateStdDev * yawRateStdDev;
+            imuHeadingVariance = headingStdDev * headingStdDev;
+        }
+
+        /**
+         * Sets the noise of the GPS.
+         * @param positionStdDev The standard deviation of the x and y position in inches.
+         * @param headingStdDev The standard deviation of the heading in radians, or `INFINITY` to ignore the GPS heading.
+         */
+        void setGPSNoise(double positionStdDev, double headingStdDev)
+        {
+            gpsPositionVariance = positionStdDev * positionStdDev;
+            gpsHeadingVariance = headingStdDev * headingStdDev;
+        }
+
+    private:
+        /**
+         * The published estimate. Kept as plain values so it can be shared through a `SeqLock`.
+         */
+        struct Estimate
+        {
+            PoseSample sample;
+            double covariance[UkfOdomState::covariance_size() * UkfOdomState::covariance_size()] = {0};
+        };
+
+        /**
+         * Resets the state to a pose with the initial uncertainty.
+         * @param pose The pose to reset to.
+         */
+        void _resetState(Pose pose)
+        {
+            filter.state.set_field<UKF_POSITION>(UKF::Vector<2>(pose.x, pose.y));
+            filter.state.set_field<UKF_HEADING>(pose.rotation);
+            filter.state.set_field<UKF_VELOCITY>(0.0);
+            filter.state.set_field<UKF_ANGULAR_VELOCITY>(0.0);
+
+            filter.covariance = Covariance::Zero();
+            filter.covariance.diagonal() << INITIAL_POSITION_VARIANCE, INITIAL_POSITION_VARIANCE,
+                INITIAL_HEADING_VARIANCE,
+                INITIAL_VELOCITY_VARIANCE,
+                INITIAL_ANGULAR_VELOCITY_VARIANCE;
+
+            processNoise = Covariance::Zero();
+            processNoise.diagonal() << POSITION_PROCESS_NOISE, POSITION_PROCESS_NOISE,
+                HEADING_PROCESS_NOISE,
+                VELOCITY_PROCESS_NOISE,
+                ANGULAR_VELOCITY_PROCESS_NOISE;
+
+            currentPose = pose;
+        }
+
+        /**
+         * Applies a pose from `setPose`. Called from the filter task.
+         */
+        void _applyPendingPose()
+        {
+            if (!hasPendingPose)
+                return;
+
+            pendingPoseMutex.take();
+            Pose pose = pendingPose;
+            hasPendingPose = false;
+            pendingPoseMutex.give();
+
+            _resetState(pose);
+            lastWheelSample = PoseSample();
+            lastGPSSample = PoseSample();
+            gpsRejectionCount = 0;
+            if (imu != nullptr)
+                imu->setHeading(pose.rotation);
+        }
+
+        /**
+         * Measures the forward velocity from the change in the wheel odometry pose.
+         * Jumps in the wheel pose, such as from `setPose`, are ignored.
+         * @param measurement The measurement to add the wheel velocity to.
+         */
+        void _measureWheels(UkfOdomMeasurement &measurement)
+        {
+            PoseSample sample = wheelOdom->getSnapshot();
+            if (sample.timestamp == lastWheelSample.timestamp)
+                return;
+
+            bool hasLastSample = lastWheelSample.timestamp != 0;
+            PoseSample lastSample = lastWheelSample;
+            lastWheelSample = sample;
+            if (!hasLastSample)
+                return;
+
+            // Project the motion onto the average heading
+            double deltaT = (sample.timestamp - lastSample.timestamp) / 1000.0;
+            double heading = lastSample.rotation + Units::diffRad(sample.rotation, lastSample.rotation) / 2;
+            double deltaDistance = (sample.x - lastSample.x) * std::cos(heading) +
+                                   (sample.y - lastSample.y) * std::sin(heading);
+
+            double velocity = deltaDistance / deltaT;
+            if (std::abs(velocity) > MAX_WHEEL_VELOCITY)
+                return;
+            measurement.set_field<UKF_WHEEL_VELOCITY>(velocity);
+        }
+
+        /**
+         * Measures the yaw rate and heading with the IMU.
+         * @param measurement The measurement to add the IMU readings to.
+         */
+        void _measureIMU(UkfOdomMeasurement &measurement)
+        {
+            if (imu == nullptr)
+                return;
+
+            double yawRate = imu->getYawRate();
+            if (yawRate != PROS_ERR_F)
+                measurement.set_field<UKF_IMU_YAW_RATE>(yawRate);
+
+            double heading = imu->getHeading();
+            if (heading != PROS_ERR_F)
+                measurement.set_field<UKF_IMU_HEADING>(_unwrapHeading(heading));
+        }
+
+        /**
+         * Measures the pose with the GPS, if the GPS has a new measurement.
+         * The GPS pose is measured in the past, so it is moved forward by the wheel motion since then.
+         * Measurements far outside the filter's uncertainty are rejected, unless the GPS disagrees for long enough
+         * that the filter is more likely to be wrong.
+         * @param measurement The measurement to add the GPS pose to.
+         */
+        void _measureGPS(UkfOdomMeasurement &measurement)
+        {
+            if (gps == nullptr)
+                return;
+
+            // Check for a new measurement
+            PoseSample sample = gps->getSnapshot();
+            if (sample.timestamp == 0 || (sample.x == lastGPSSample.x && sample.y == lastGPSSample.y))
+                return;
+            lastGPSSample = sample;
+
+            // Latency
+            double x = sample.x;
+            double y = sample.y;
+            double rotation = sample.rotation;
+            if (lastWheelSample.timestamp != 0)
+            {
+                Pose pastWheelPose = wheelOdom->getPoseAt(sample.timestamp);
+                x += lastWheelSample.x - pastWheelPose.x;
+                y += lastWheelSample.y - pastWheelPose.y;
+                rotation += Units::diffRad(lastWheelSample.rotation, pastWheelPose.rotation);
+            }
+
+            UkfOdomMeasurement gpsMeasurement;
+            gpsMeasurement.set_field<UKF_GPS_POSITION>(UKF::Vector<2>(x, y));
+            if (std::isfinite(gpsHeadingVariance))
+                gpsMeasurement.set_field<UKF_GPS_HEADING>(_unwrapHeading(rotation));
+
+            // Gate
+            bool isForced = gpsRejectionCount >= MAX_GPS_REJECTIONS;
+            if (!isForced && _getMahalanobisDistance(gpsMeasurement) > GPS_GATE)
+            {
+                gpsRejectionCount++;
+                if (gpsRejectionCount == MAX_GPS_REJECTIONS)
+                    Logger::warn("UnscentedKalmanFilterOdom: GPS disagrees with odometry, relocking");
+                return;
+            }
+            gpsRejectionCount = 0;
+
+            measurement.set_field<UKF_GPS_POSITION>(gpsMeasurement.get_field<UKF_GPS_POSITION>());
+            if (std::isfinite(gpsHeadingVariance))
+                measurement.set_field<UKF_GPS_HEADING>(gpsMeasurement.get_field<UKF_GPS_HEADING>());
+        }
+
+        /**
+         * Gets how far a measurement is from the predicted measurement, scaled by their combined uncertainty.
+         * Must be called after the prediction step, since it runs the predicted sigma points through the measurement model.
+         * @param measurement The measurement to check.
+         * @return The squared Mahalanobis distance of the innovation.
+         */
+        double _getMahalanobisDistance(UkfOdomMeasurement &measurement)
+        {
+            filter.innovation_step(measurement);
+            auto &innovation = filter.innovation;
+            double distance = innovation.dot(filter.innovation_covariance.ldlt().solve(innovation));
+            return std::isfinite(distance) ? distance : INFINITY;
+        }
+
+        /**
+         * Moves a heading measurement to within half a turn of the filter's heading.
+         * The filter heading is never wrapped, so sigma points on either side of a full turn still average correctly.
+         * @param heading The measured heading in radians.
+         * @return The equivalent heading closest to the filter's heading in radians.
+         */
+        double _unwrapHeading(double heading)
+        {
+            double filterHeading = filter.state.get_field<UKF_HEADING>();
+            return filterHeading + Units::diffRad(heading, filterHeading);
+        }
+
+        inline static ProfileSite updateProfile = ProfileSite("UnscentedKalmanFilterOdom.update");
+
+        static constexpr double INITIAL_POSITION_VARIANCE = 1.0;          // in^2
+        static constexpr double INITIAL_HEADING_VARIANCE = 0.01;          // rad^2
+        static constexpr double INITIAL_VELOCITY_VARIANCE = 1.0;          // (in/s)^2
+        static constexpr double INITIAL_ANGULAR_VELOCITY_VARIANCE = 0.01; // (rad/s)^2
+        static constexpr double POSITION_PROCESS_NOISE = 1.0;             // in^2/s
+        static constexpr double HEADING_PROCESS_NOISE = 0.01;             // rad^2/s
+        static constexpr double VELOCITY_PROCESS_NOISE = 2500.0;          // (in/s)^2/s
+        static constexpr double ANGULAR_VELOCITY_PROCESS_NOISE = 100.0;   // (rad/s)^2/s
+        static constexpr double MAX_WHEEL_VELOCITY = 200.0;               // in/s
+        static constexpr double GPS_GATE = 11.34;                         // chi^2, 3 DOF at 99%
+        static constexpr int MAX_GPS_REJECTIONS = 25;
+
+        // Sources
+        OdomSource *wheelOdom;
+        IMU *imu;
+        OdomSource *gps;
+
+        // Sensor Noise
+        double wheelVelocityVariance = 4.0; // (in/s)^2
+        double imuYawRateVariance = 0.0004; // (rad/s)^2
+        double imuHeadingVariance = 0.0001; // rad^2
+        double gpsPositionVariance = 4.0;   // in^2
+        double gpsHeadingVariance = 0.01;   // rad^2
+
+        // Filter
+        UKF::Core<UkfOdomState, UkfOdomMeasurement, UkfOdomProcessModel> filter;
+        Covariance processNoise;
+        uint32_t lastUpdateTimestamp = 0;
+        PoseSample lastWheelSample;
+        PoseSample lastGPSSample;
+        int gpsRejectionCount = 0;
+
+        // Publish
+        Pose currentPose = Pose();
+        SeqLock<Estimate> published;
+        Pose pendingPose = Pose();
+        std::atomic<bool> hasPendingPose = false;
+        pros::Mutex pendingPoseMutex;
+    };
+}
\ No newline at end of file
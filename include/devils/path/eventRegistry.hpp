@@ -0,0 +1,79 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Interns event names into small integer IDs.
+     * Names are interned when paths are loaded, so events can be compared by ID at runtime.
+     */
+    class EventRegistry
+    {
+    public:
+        /**
+         * Gets the ID of an event name, registering it if it has not been seen before.
+         * @param name The name of the event (e.g. `intake`)
+         * @return The ID of the event name.
+         */
+        static int intern(const std::string &name)
+        {
+            auto &ids = _getIDs();
+            auto entry = ids.find(name);
+            if (entry != ids.end())
+                return entry->second;
+
+            int id = _getNames().size();
+            ids[name] = id;
+            _getNames().push_back(name);
+            return id;
+        }
+
+        /**
+         * Gets the name of an event ID.
+         * @param id The ID of the event name.
+         * @return The name of the event or an empty string if the ID is not registered.
+         */
+        static std::string getName(int id)
+        {
+            auto &names = _getNames();
+            if (id < 0 || id >= names.size())
+                return "";
+            return names[id];
+        }
+
+        /**
+         * Gets the number of registered event names.
+         * @return The number of registered event names.
+         */
+        static int getCount()
+        {
+            return _getNames().size();
+        }
+
+        /**
+         * Gets the map of names to IDs.
+         * Stored as a function-local static so paths loaded during static initialization can intern safely.
+         * @return A reference to the map of names to IDs.
+         */
+        static std::map<std::string, int> &_getIDs()
+        {
+            static std::map<std::string, int> ids;
+            return ids;
+        }
+
+        /**
+         * Gets the list of names, indexed by ID.
+         * @return A reference to the list of names.
+         */
+        static std::vector<std::string> &_getNames()
+        {
+            static std::vector<std::string> names;
+            return names;
+        }
+
+    private:
+        EventRegistry() = delete;
+    };
+}
@@ -24,6 +24,37 @@ namespace devils
         /// @brief The indices of each control point in the path. `controlPointIndices[i]` is the index of the `i`th control point in the path.
         std::vector<int> controlPointIndices = {};
 
+        /// @brief The distance along the path to each path point in inches. `pathDistances[i]` is the distance to `pathPoints[i]`.
+        std::vector<double> pathDistances = {};
+
+        /**
+         * Calculates the cumulative distance along the path to each path point.
+         * Called automatically by `PathGenerator`.
+         */
+        void calculateDistances()
+        {
+            pathDistances.clear();
+            pathDistances.reserve(pathPoints.size());
+
+            double distance = 0;
+            for (int i = 0; i < pathPoints.size(); i++)
+            {
+                if (i > 0)
+                    distance += pathPoints[i].distanceTo(pathPoints[i - 1]);
+                pathDistances.push_back(distance);
+            }
+        }
+
+        /**
+         * Gets the distance along the path to a control point.
+         * @param controlPointIndex The index of the control point.
+         * @return The distance along the path in inches.
+         */
+        double getControlPointDistance(int controlPointIndex)
+        {
+            return pathDistances[controlPointIndices[controlPointIndex]];
+        }
+
         /**
          * Gets the starting pose of the motion profile.
          * @return The starting pose of the motion profile as an Pose.
@@ -1,7 +1,9 @@
 #pragma once
+#include <cstdlib>
 #include <string>
 #include <vector>
 #include "../geometry/pose.hpp"
+#include "eventRegistry.hpp"
 
 namespace devils
 {
@@ -13,7 +15,10 @@ namespace devils
         PathEvent(std::string name, std::string params)
             : id(std::rand()),
               name(name),
-              params(params)
+              params(params),
+              nameID(EventRegistry::intern(name)),
+              value(std::strtod(params.c_str(), nullptr)),
+              isAfterPause(params == "afterPause")
         {
         }
 
@@ -23,6 +28,12 @@ namespace devils
         std::string name;
         /// @brief The parameters of the event
         std::string params;
+        /// @brief The interned ID of the event name from `EventRegistry`
+        int nameID = -1;
+        /// @brief The parameters parsed as a number, or 0 if the parameters are not numeric
+        double value = 0;
+        /// @brief Whether the event should be skipped while the robot is paused
+        bool isAfterPause = false;
 
         /**
          * Converts the event to a string.
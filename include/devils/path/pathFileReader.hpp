@@ -118,7 +118,8 @@ namespace devils
             // Split the line into properties
             auto split = StringUtils::split(line, ' ');
             int index = 0;
-            PathEvent event = PathEvent("", "");
+            std::string name = "";
+            std::string params = "";
 
             // Iterate through each property
             for (int i = 0; i < split.size(); i++)
@@ -128,15 +129,15 @@ namespace devils
                     continue;
                 // Parse Index to Property
                 if (index == 0)
-                    event.name = split[i];
+                    name = split[i];
                 if (index == 1)
-                    event.params = split[i];
+                    params = split[i];
                 // Increment Index
                 index++;
             }
 
             // Return the event
-            return event;
+            return PathEvent(name, params);
         }
 
     private:
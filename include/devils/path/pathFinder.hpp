@@ -26,6 +26,13 @@ namespace devils
             // Get Start Time
             int startTime = pros::millis();
 
+            // Nothing to search
+            if (occupancyGrid.width <= 0 || occupancyGrid.height <= 0)
+            {
+                Logger::error("PathFinder: Occupancy grid is empty");
+                return GeneratedPath();
+            }
+
             // Get grid cells from pose
             GridPose startCell = _poseToGrid(startPose, occupancyGrid);
             GridPose endCell = _poseToGrid(endPose, occupancyGrid);
@@ -125,6 +132,7 @@ namespace devils
             // Path could not be solved
             Logger::error("PathFinder: Could not resolve path");
             Logger::info(startPose.toString() + " >>> " + endPose.toString());
+            return GeneratedPath();
         }
 
     protected:
@@ -269,8 +277,8 @@ namespace devils
             double yOrgin = tlPoseY / cellHeight;
 
             // Keep within bounds
-            xOrgin = std::clamp((int)xOrgin, 0, grid.width);
-            yOrgin = std::clamp((int)yOrgin, 0, grid.height);
+            xOrgin = std::clamp((int)xOrgin, 0, std::max(grid.width - 1, 0));
+            yOrgin = std::clamp((int)yOrgin, 0, std::max(grid.height - 1, 0));
 
             GridPose orginCell = GridPose{(int)xOrgin, (int)yOrgin};
             if (!grid.getOccupied(xOrgin, yOrgin))
@@ -282,6 +290,8 @@ namespace devils
                 for (int y = 0; y < grid.height; y++)
                     if (!grid.getOccupied(x, y))
                         allCells.push_back(GridPose{x, y});
+            if (allCells.empty())
+                return orginCell;
 
             // Find the closest cell
             // TODO: Replace brute-force w/ more efficient algorithm
@@ -38,11 +38,13 @@ namespace devils
             controlPointIndices.push_back(pathPoints.size() - 1);
 
             // Return the generated path
-            return GeneratedPath{
+            GeneratedPath path = GeneratedPath{
                 DT,
                 controlPoints,
                 pathPoints,
                 controlPointIndices};
+            path.calculateDistances();
+            return path;
         }
 
         /**
@@ -91,11 +93,13 @@ namespace devils
             controlPointIndices.push_back(pathPoints.size() - 1);
 
             // Return the generated path
-            return GeneratedPath{
+            GeneratedPath path = GeneratedPath{
                 DT,
                 controlPoints,
                 pathPoints,
                 controlPointIndices};
+            path.calculateDistances();
+            return path;
         }
 
     private:
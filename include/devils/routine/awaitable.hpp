@@ -0,0 +1,40 @@
+#pragma once
+#include <functional>
+#include <cstdint>
+
+namespace devils
+{
+    /**
+     * Describes what a suspended `Routine` is waiting for.
+     * A routine resumes once the deadline has passed and the condition is true.
+     */
+    struct Awaitable
+    {
+        /// @brief The earliest time the routine can resume in milliseconds, or 0 to resume immediately.
+        uint32_t deadline = 0;
+
+        /// @brief Polled by the runner until it returns true, or empty if the routine only waits for the deadline.
+        std::function<bool()> condition = nullptr;
+
+        /**
+         * Checks if the routine waiting on this can resume.
+         * @param now The current time in milliseconds.
+         * @return True if the routine can resume, false otherwise.
+         */
+        bool isReady(uint32_t now)
+        {
+            if (deadline != 0 && (int32_t)(now - deadline) < 0)
+                return false;
+            return !condition || condition();
+        }
+
+        /**
+         * Checks if the runner needs to poll the condition each tick.
+         * @return True if the awaitable has a condition, false if it only has a deadline.
+         */
+        bool isPolled()
+        {
+            return (bool)condition;
+        }
+    };
+}
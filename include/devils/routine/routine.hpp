@@ -0,0 +1,181 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "awaitable.hpp"
+#include "../control/autoController.hpp"
+#include "../control/pursuitController.hpp"
+#include "../path/generatedPath.hpp"
+
+/**
+ * Starts the body of `Routine::step`. Must be paired with `ROUTINE_END`.
+ * The body is resumed from the last `ROUTINE_AWAIT` using a switch on the line number,
+ * so local variables do not survive an await. Store state in members instead.
+ */
+#define ROUTINE_BEGIN()         \
+    switch (this->_resumePoint) \
+    {                           \
+    case 0:
+
+/**
+ * Suspends the routine until the awaitable is ready.
+ * @param awaitable The `Awaitable` to wait for (e.g. `waitMs(500)`)
+ */
+#define ROUTINE_AWAIT(awaitable)             \
+    do                                       \
+    {                                        \
+        this->_suspend(awaitable, __LINE__); \
+        return;                              \
+    case __LINE__:;                          \
+    } while (0)
+
+/**
+ * Ends the body of `Routine::step` and marks the routine as finished.
+ */
+#define ROUTINE_END() \
+    }                 \
+    this->_finish();
+
+namespace devils
+{
+    /**
+     * Represents a stackless coroutine used to write autonomous routines as straight-line code.
+     * Many routines can be interleaved in a single `RoutineRunner` task without a stack per routine.
+     *
+     * Subclasses implement `step` between `ROUTINE_BEGIN()` and `ROUTINE_END()`,
+     * and suspend with `ROUTINE_AWAIT(...)`.
+     */
+    struct Routine
+    {
+        virtual ~Routine() = default;
+
+        /**
+         * Runs the routine until it awaits or finishes.
+         */
+        virtual void step() = 0;
+
+        /**
+         * Restarts the routine from the beginning.
+         */
+        virtual void reset()
+        {
+            _resumePoint = 0;
+            isFinished = false;
+            awaitable = Awaitable();
+        }
+
+        /**
+         * Checks if the routine has finished.
+         * @return True if the routine has finished, false otherwise.
+         */
+        bool getFinished()
+        {
+            return isFinished;
+        }
+
+        /**
+         * Gets what the routine is waiting for.
+         * @return The current awaitable of the routine.
+         */
+        Awaitable &getAwaitable()
+        {
+            return awaitable;
+        }
+
+        /**
+         * Waits for a duration.
+         * @param duration The time to wait in milliseconds.
+         * @return An awaitable that is ready after the duration.
+         */
+        static Awaitable waitMs(uint32_t duration)
+        {
+            return Awaitable{pros::millis() + duration, nullptr};
+        }
+
+        /**
+         * Waits until a condition is true. The condition is checked each runner tick.
+         * @param condition The condition to wait for.
+         * @return An awaitable that is ready once the condition is true.
+         */
+        static Awaitable waitUntil(std::function<bool()> condition)
+        {
+            return Awaitable{0, condition};
+        }
+
+        /**
+         * Runs an auto controller until it finishes.
+         * The controller is reset, then updated each runner tick.
+         * @param controller The controller to run.
+         * @return An awaitable that is ready once the controller finishes.
+         */
+        static Awaitable runController(AutoController &controller)
+        {
+            controller.reset();
+            return Awaitable{0, [&controller]()
+                             {
+                                 controller.update();
+                                 return controller.getFinished();
+                             }};
+        }
+
+        /**
+         * Follows a path until the end.
+         * @param controller The pursuit controller used to follow the path.
+         * @param path The path to follow.
+         * @return An awaitable that is ready once the path is finished.
+         */
+        static Awaitable followPath(PursuitController &controller, GeneratedPath &path)
+        {
+            controller.setPath(&path);
+            return runController(controller);
+        }
+
+        /**
+         * Waits until a launcher or flywheel is at speed.
+         * @param launcher Any object with an `isAtSpeed()` method (e.g. `LauncherSystem`)
+         * @return An awaitable that is ready once the launcher is at speed.
+         */
+        template <typename T>
+        static Awaitable atSpeed(T &launcher)
+        {
+            return Awaitable{0, [&launcher]()
+                             { return launcher.isAtSpeed(); }};
+        }
+
+        /**
+         * Waits until another routine finishes.
+         * @param routine The routine to wait for.
+         * @return An awaitable that is ready once the routine finishes.
+         */
+        static Awaitable waitFor(Routine &routine)
+        {
+            return Awaitable{0, [&routine]()
+                             { return routine.getFinished(); }};
+        }
+
+        /**
+         * Suspends the routine. Called by `ROUTINE_AWAIT`.
+         * @param newAwaitable What the routine should wait for.
+         * @param resumePoint The line to resume from.
+         */
+        void _suspend(Awaitable newAwaitable, int resumePoint)
+        {
+            awaitable = newAwaitable;
+            _resumePoint = resumePoint;
+        }
+
+        /**
+         * Marks the routine as finished. Called by `ROUTINE_END`.
+         */
+        void _finish()
+        {
+            isFinished = true;
+            awaitable = Awaitable();
+        }
+
+        /// @brief The line to resume from, or 0 to start from the beginning.
+        int _resumePoint = 0;
+
+    protected:
+        bool isFinished = false;
+        Awaitable awaitable;
+    };
+}
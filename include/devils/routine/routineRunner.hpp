@@ -0,0 +1,115 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "routine.hpp"
+#include "../utils/runnable.hpp"
+#include "../utils/profiler.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Interleaves many `Routine`s in a single task.
+     * Sleeps until the earliest deadline, and only wakes every `POLL_PERIOD` while a routine is polling a condition.
+     */
+    class RoutineRunner : public Runnable
+    {
+    public:
+        /**
+         * Starts a routine from the beginning. Restarts it if it is already running.
+         * @param routine The routine to start.
+         */
+        void start(Routine &routine)
+        {
+            routine.reset();
+            if (std::find(routines.begin(), routines.end(), &routine) == routines.end())
+                routines.push_back(&routine);
+        }
+
+        /**
+         * Stops a routine without finishing it.
+         * @param routine The routine to stop.
+         */
+        void stop(Routine &routine)
+        {
+            routines.erase(std::remove(routines.begin(), routines.end(), &routine), routines.end());
+        }
+
+        /**
+         * Stops all routines.
+         */
+        void stopAll()
+        {
+            routines.clear();
+        }
+
+        /**
+         * Resumes every routine whose awaitable is ready and removes finished routines.
+         */
+        void update() override
+        {
+            ScopedTimer timer(updateProfile);
+
+            uint32_t now = pros::millis();
+            for (int i = 0; i < routines.size(); i++)
+            {
+                Routine *routine = routines[i];
+                if (routine->getAwaitable().isReady(now))
+                    routine->step();
+            }
+
+            routines.erase(std::remove_if(routines.begin(), routines.end(), [](Routine *routine)
+                                          { return routine->getFinished(); }),
+                           routines.end());
+        }
+
+        /**
+         * Runs the routines until they have all finished.
+         */
+        void runSync() override
+        {
+            while (!isIdle())
+            {
+                update();
+                pros::delay(_getSleepTime());
+            }
+        }
+
+        /**
+         * Checks if any routines are running.
+         * @return True if no routines are running, false otherwise.
+         */
+        bool isIdle()
+        {
+            return routines.empty();
+        }
+
+        /**
+         * Gets the time until a routine could next be ready.
+         * @return The time to sleep in milliseconds.
+         */
+        uint32_t _getSleepTime()
+        {
+            uint32_t now = pros::millis();
+            uint32_t sleepTime = MAX_SLEEP_TIME;
+            for (Routine *routine : routines)
+            {
+                Awaitable &awaitable = routine->getAwaitable();
+                if (awaitable.isPolled() || awaitable.deadline == 0)
+                    return POLL_PERIOD;
+
+                int32_t timeUntilDeadline = (int32_t)(awaitable.deadline - now);
+                sleepTime = std::min(sleepTime, (uint32_t)std::max(timeUntilDeadline, 1));
+            }
+            return sleepTime;
+        }
+
+    private:
+        inline static ProfileSite updateProfile = ProfileSite("RoutineRunner.update");
+
+        static constexpr uint32_t POLL_PERIOD = 10;     // ms
+        static constexpr uint32_t MAX_SLEEP_TIME = 100; // ms
+
+        std::vector<Routine *> routines;
+    };
+}
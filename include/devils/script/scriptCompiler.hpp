@@ -0,0 +1,378 @@
+#pragma once
+#include "scriptProgram.hpp"
+#include "../utils/logger.hpp"
+#include "../hardware/sdCard.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Compiles autonomous scripts into bytecode for the `ScriptVM`.
+     *
+     * Scripts are line based, with one statement per line:
+     * - `EVENT <name> [params]` dispatches a path event
+     * - `WAIT <ms>` sleeps the current thread
+     * - `WAITUNTIL <condition>` yields until the condition is true
+     * - `IF <condition>` ... [`ELSE` ...] `END`
+     * - `LOOP <count>` ... `END`
+     * - `PARALLEL` `BRANCH` ... `BRANCH` ... `END` runs each branch at the same time and waits for all of them
+     *
+     * Conditions are either `<sensor>` (true when non-zero) or `<sensor> <op> <value>` with `op` one of `> < >= <= == !=`.
+     * Lines starting with `#` are comments.
+     */
+    class ScriptCompiler
+    {
+    public:
+        /**
+         * Reads and compiles a script from the SD card.
+         * @param fileName The name of the script file.
+         * @return The compiled script.
+         */
+        static ScriptProgram readFromSD(std::string fileName = SCRIPT_FILE_PATH)
+        {
+            return compile(SDCard::readToString(fileName));
+        }
+
+        /**
+         * Compiles a script from a string.
+         * @param source The source of the script.
+         * @return The compiled script. `isValid` is false if there were errors.
+         */
+        static ScriptProgram compile(std::string source)
+        {
+            ScriptProgram program;
+            std::vector<Block> blocks;
+
+            // Read from string
+            std::string line;
+            std::istringstream readStream(source);
+            int lineNumber = 0;
+
+            // Iterate through each line
+            while (std::getline(readStream, line))
+            {
+                lineNumber++;
+
+                // Split the line into tokens
+                std::vector<std::string> tokens;
+                std::istringstream lineStream(line);
+                std::string token;
+                while (lineStream >> token)
+                    tokens.push_back(token);
+
+                if (tokens.empty() || tokens[0].rfind("#") == 0)
+                    continue;
+                if (tokens[0] == "ENDSCRIPT")
+                    break;
+                if (tokens[0] == "SCRIPT")
+                    continue;
+
+                if (!_compileLine(program, blocks, tokens))
+                {
+                    Logger::error("ScriptCompiler: Invalid statement on line " + std::to_string(lineNumber) + ": " + line);
+                    program.isValid = false;
+                }
+            }
+
+            // Check for unclosed blocks
+            if (!blocks.empty())
+            {
+                Logger::error("ScriptCompiler: Missing END for " + std::to_string(blocks.size()) + " block(s)");
+                program.isValid = false;
+            }
+
+            _emit(program, ScriptInstruction::HALT);
+
+            // Check for jump targets that don't fit in an instruction
+            if (program.code.size() > ScriptProgram::MAX_INSTRUCTIONS)
+            {
+                Logger::error("ScriptCompiler: Script is too long (" + std::to_string(program.code.size()) + " instructions)");
+                program.isValid = false;
+            }
+            return program;
+        }
+
+    private:
+        ScriptCompiler() = delete;
+
+        inline static const std::string SCRIPT_FILE_PATH = "script.txt";
+
+        /**
+         * Represents a block that has not been closed with `END` yet.
+         */
+        struct Block
+        {
+            enum Type
+            {
+                IF,
+                ELSE,
+                LOOP,
+                PARALLEL,
+                BRANCH
+            };
+
+            /// @brief The type of block.
+            Type type;
+            /// @brief The instruction to patch when the block ends, or the start of the body for loops.
+            int patchIndex = -1;
+            /// @brief The loop counter used by the block.
+            int counter = 0;
+            /// @brief The start of each branch in a parallel block.
+            std::vector<int> branchStarts = {};
+        };
+
+        /**
+         * Compiles a single statement.
+         * @param program The program to add instructions to.
+         * @param blocks The stack of open blocks.
+         * @param tokens The tokens of the statement.
+         * @return True if the statement was valid, false otherwise.
+         */
+        static bool _compileLine(ScriptProgram &program, std::vector<Block> &blocks, std::vector<std::string> &tokens)
+        {
+            std::string &keyword = tokens[0];
+
+            // Statements in a parallel block must be inside a branch
+            if (!blocks.empty() && blocks.back().type == Block::PARALLEL && keyword != "BRANCH" && keyword != "END")
+                return false;
+
+            if (keyword == "EVENT" && tokens.size() >= 2)
+            {
+                program.events.push_back(PathEvent(tokens[1], tokens.size() >= 3 ? tokens[2] : ""));
+                _emit(program, ScriptInstruction::EVENT).arg = program.events.size() - 1;
+                return true;
+            }
+            if (keyword == "WAIT" && tokens.size() == 2)
+            {
+                double duration;
+                if (!_parseNumber(tokens[1], duration) || duration < 0)
+                    return false;
+                _emit(program, ScriptInstruction::WAIT).value = duration;
+                return true;
+            }
+            if (keyword == "WAITUNTIL")
+            {
+                ScriptInstruction &instruction = _emit(program, ScriptInstruction::WAIT_UNTIL);
+                return _parseCondition(program, instruction, tokens);
+            }
+            if (keyword == "IF")
+            {
+                blocks.push_back(Block{Block::IF, (int)program.code.size()});
+                ScriptInstruction &instruction = _emit(program, ScriptInstruction::JUMP_IF_NOT);
+                return _parseCondition(program, instruction, tokens);
+            }
+            if (keyword == "ELSE")
+            {
+                if (blocks.empty() || blocks.back().type != Block::IF)
+                    return false;
+
+                // Jump over the else body at the end of the if body
+                int jumpIndex = program.code.size();
+                _emit(program, ScriptInstruction::JUMP);
+                program.code[blocks.back().patchIndex].arg = program.code.size();
+                blocks.back() = Block{Block::ELSE, jumpIndex};
+                return true;
+            }
+            if (keyword == "LOOP" && tokens.size() == 2)
+            {
+                int count;
+                if (!_parseInteger(tokens[1], count))
+                    return false;
+                int counter = std::count_if(blocks.begin(), blocks.end(), [](Block &block)
+                                            { return block.type == Block::LOOP; });
+                if (count <= 0 || counter >= ScriptProgram::MAX_LOOP_DEPTH)
+                    return false;
+
+                ScriptInstruction &instruction = _emit(program, ScriptInstruction::LOOP_INIT);
+                instruction.sensor = counter;
+                instruction.value = count;
+                blocks.push_back(Block{Block::LOOP, (int)program.code.size(), counter});
+                program.loopCounterCount = std::max(program.loopCounterCount, counter + 1);
+                return true;
+            }
+            if (keyword == "PARALLEL")
+            {
+                // Jump over the branch bodies to the forks
+                blocks.push_back(Block{Block::PARALLEL, (int)program.code.size()});
+                _emit(program, ScriptInstruction::JUMP);
+                return true;
+            }
+            if (keyword == "BRANCH")
+            {
+                if (!blocks.empty() && blocks.back().type == Block::BRANCH)
+                {
+                    _emit(program, ScriptInstruction::HALT);
+                    blocks.pop_back();
+                }
+                if (blocks.empty() || blocks.back().type != Block::PARALLEL)
+                    return false;
+
+                blocks.back().branchStarts.push_back(program.code.size());
+                blocks.push_back(Block{Block::BRANCH, -1});
+                return true;
+            }
+            if (keyword == "END")
+                return _compileEnd(program, blocks);
+
+            return false;
+        }
+
+        /**
+         * Closes the innermost block.
+         * @param program The program to add instructions to.
+         * @param blocks The stack of open blocks.
+         * @return True if there was a block to close, false otherwise.
+         */
+        static bool _compileEnd(ScriptProgram &program, std::vector<Block> &blocks)
+        {
+            if (blocks.empty())
+                return false;
+
+            // Close the last branch
+            if (blocks.back().type == Block::BRANCH)
+            {
+                _emit(program, ScriptInstruction::HALT);
+                blocks.pop_back();
+            }
+
+            Block block = blocks.back();
+            blocks.pop_back();
+            switch (block.type)
+            {
+            case Block::IF:
+            case Block::ELSE:
+                program.code[block.patchIndex].arg = program.code.size();
+                break;
+            case Block::LOOP:
+            {
+                ScriptInstruction &instruction = _emit(program, ScriptInstruction::LOOP_NEXT);
+                instruction.sensor = block.counter;
+                instruction.arg = block.patchIndex;
+                break;
+            }
+            case Block::PARALLEL:
+                program.code[block.patchIndex].arg = program.code.size();
+                for (int branchStart : block.branchStarts)
+                    _emit(program, ScriptInstruction::FORK).arg = branchStart;
+                _emit(program, ScriptInstruction::JOIN);
+                break;
+            default:
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * Parses a condition in the form `<sensor>` or `<sensor> <op> <value>`.
+         * @param program The program to register the sensor in.
+         * @param instruction The instruction to store the condition in.
+         * @param tokens The tokens of the statement, starting with the keyword.
+         * @return True if the condition was valid, false otherwise.
+         */
+        static bool _parseCondition(ScriptProgram &program, ScriptInstruction &instruction, std::vector<std::string> &tokens)
+        {
+            if (tokens.size() != 2 && tokens.size() != 4)
+                return false;
+            instruction.sensor = _getSensorIndex(program, tokens[1]);
+
+            // Truthy
+            if (tokens.size() == 2)
+            {
+                instruction.compare = ScriptInstruction::NOT_EQUAL;
+                instruction.value = 0;
+                return true;
+            }
+
+            // Comparison
+            std::string &op = tokens[2];
+            if (op == ">")
+                instruction.compare = ScriptInstruction::GREATER;
+            else if (op == "<")
+                instruction.compare = ScriptInstruction::LESS;
+            else if (op == ">=")
+                instruction.compare = ScriptInstruction::GREATER_EQUAL;
+            else if (op == "<=")
+                instruction.compare = ScriptInstruction::LESS_EQUAL;
+            else if (op == "==")
+                instruction.compare = ScriptInstruction::EQUAL;
+            else if (op == "!=")
+                instruction.compare = ScriptInstruction::NOT_EQUAL;
+            else
+                return false;
+
+            double value;
+            if (!_parseNumber(tokens[3], value))
+                return false;
+            instruction.value = value;
+            return true;
+        }
+
+        /**
+         * Parses a token as a number. Unlike `std::stod`, never throws on bad input.
+         * @param token The token to parse.
+         * @param value The parsed number.
+         * @return True if the whole token was a finite number, false otherwise.
+         */
+        static bool _parseNumber(std::string &token, double &value)
+        {
+            char *end = nullptr;
+            errno = 0;
+            value = std::strtod(token.c_str(), &end);
+            return end != token.c_str() && *end == '\0' && errno == 0 && std::isfinite(value);
+        }
+
+        /**
+         * Parses a token as an integer. Unlike `std::stoi`, never throws on bad input.
+         * @param token The token to parse.
+         * @param value The parsed integer.
+         * @return True if the whole token was an integer that fits in an `int`, false otherwise.
+         */
+        static bool _parseInteger(std::string &token, int &value)
+        {
+            char *end = nullptr;
+            errno = 0;
+            long parsed = std::strtol(token.c_str(), &end, 10);
+            if (end == token.c_str() || *end != '\0' || errno != 0 || parsed < INT_MIN || parsed > INT_MAX)
+                return false;
+            value = (int)parsed;
+            return true;
+        }
+
+        /**
+         * Gets the index of a sensor, registering it if it has not been used yet.
+         * @param program The program to register the sensor in.
+         * @param name The name of the sensor.
+         * @return The index of the sensor.
+         */
+        static int _getSensorIndex(ScriptProgram &program, std::string &name)
+        {
+            auto entry = std::find(program.sensorNames.begin(), program.sensorNames.end(), name);
+            if (entry != program.sensorNames.end())
+                return entry - program.sensorNames.begin();
+
+            program.sensorNames.push_back(name);
+            return program.sensorNames.size() - 1;
+        }
+
+        /**
+         * Appends an instruction to the program.
+         * @param program The program to append to.
+         * @param op The operation of the instruction.
+         * @return A reference to the new instruction.
+         */
+        static ScriptInstruction &_emit(ScriptProgram &program, ScriptInstruction::OpCode op)
+        {
+            ScriptInstruction instruction;
+            instruction.op = op;
+            program.code.push_back(instruction);
+            return program.code.back();
+        }
+    };
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "../path/pathFile.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Represents a single instruction of a compiled script.
+     */
+    struct ScriptInstruction
+    {
+        /**
+         * Represents the operation of an instruction.
+         */
+        enum OpCode : uint8_t
+        {
+            /// @brief Ends the current thread.
+            HALT,
+            /// @brief Dispatches `events[arg]`.
+            EVENT,
+            /// @brief Sleeps the current thread for `value` milliseconds.
+            WAIT,
+            /// @brief Yields until `sensors[sensor] <compare> value` is true.
+            WAIT_UNTIL,
+            /// @brief Jumps to `arg`.
+            JUMP,
+            /// @brief Jumps to `arg` if `sensors[sensor] <compare> value` is false.
+            JUMP_IF_NOT,
+            /// @brief Sets loop counter `sensor` to `value`.
+            LOOP_INIT,
+            /// @brief Decrements loop counter `sensor` and jumps to `arg` if it is still positive.
+            LOOP_NEXT,
+            /// @brief Starts a new thread at `arg`.
+            FORK,
+            /// @brief Yields until every thread forked by the current thread has halted.
+            JOIN
+        };
+
+        /**
+         * Represents how a sensor is compared to a value.
+         */
+        enum Compare : uint8_t
+        {
+            GREATER,
+            LESS,
+            GREATER_EQUAL,
+            LESS_EQUAL,
+            EQUAL,
+            NOT_EQUAL
+        };
+
+        /// @brief The operation to run.
+        OpCode op = HALT;
+        /// @brief How the sensor is compared to the value.
+        Compare compare = NOT_EQUAL;
+        /// @brief The index of the sensor or loop counter.
+        uint16_t sensor = 0;
+        /// @brief The jump target, event index or sensor index depending on `op`.
+        uint16_t arg = 0;
+        /// @brief The value to compare against, wait duration or loop count depending on `op`.
+        float value = 0;
+    };
+
+    /**
+     * Represents a script compiled into bytecode by `ScriptCompiler`.
+     */
+    struct ScriptProgram
+    {
+        /// @brief The maximum number of nested loops in a script.
+        static constexpr int MAX_LOOP_DEPTH = 8;
+
+        /// @brief The maximum number of instructions in a script, since jump targets are 16-bit.
+        static constexpr int MAX_INSTRUCTIONS = UINT16_MAX;
+
+        /// @brief The instructions of the script. Execution starts at index 0.
+        std::vector<ScriptInstruction> code = {};
+
+        /// @brief The events referenced by `EVENT` instructions.
+        PathEvents events = {};
+
+        /// @brief The names of the sensors referenced by the script. Bound to functions by `ScriptVM`.
+        std::vector<std::string> sensorNames = {};
+
+        /// @brief The number of loop counters each thread needs.
+        int loopCounterCount = 0;
+
+        /// @brief Whether the script compiled without errors.
+        bool isValid = true;
+    };
+}
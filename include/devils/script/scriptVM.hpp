@@ -0,0 +1,285 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "scriptProgram.hpp"
+#include "../utils/runnable.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/profiler.hpp"
+#include "../utils/eventDispatcher.hpp"
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Runs a compiled `ScriptProgram`.
+     * Each `PARALLEL` branch runs on a lightweight thread with its own program counter and loop counters,
+     * and all threads are stepped round-robin from a single `update` call.
+     * Events are sent to an `EventDispatcher`, so scripts share handlers with path events.
+     */
+    class ScriptVM : public Runnable
+    {
+    public:
+        /**
+         * Represents a function that reads a value for script conditions.
+         */
+        typedef std::function<double()> Sensor;
+
+        /**
+         * Creates a new script VM.
+         * @param dispatcher The dispatcher to send script events to.
+         */
+        ScriptVM(EventDispatcher &dispatcher)
+            : dispatcher(dispatcher)
+        {
+        }
+
+        /**
+         * Binds a sensor name to a function. Must be called before `load`.
+         * @param name The name of the sensor used in scripts.
+         * @param sensor The function that reads the sensor.
+         */
+        void bindSensor(std::string name, Sensor sensor)
+        {
+            sensorBindings[name] = sensor;
+        }
+
+        /**
+         * Loads a program and starts it from the beginning.
+         * Sensors are resolved once here, so conditions are a single function call at runtime.
+         * @param newProgram The program to run.
+         */
+        void load(ScriptProgram newProgram)
+        {
+            stop();
+            if (!newProgram.isValid)
+            {
+                Logger::error("ScriptVM: Refusing to load an invalid script");
+                return;
+            }
+            program = newProgram;
+
+            // Resolve Sensors
+            sensors.clear();
+            for (std::string &name : program.sensorNames)
+            {
+                auto binding = sensorBindings.find(name);
+                if (binding == sensorBindings.end())
+                    Logger::warn("ScriptVM: Unbound sensor " + name);
+                sensors.push_back(binding != sensorBindings.end() ? binding->second : nullptr);
+            }
+
+            // Start Main Thread
+            _startThread(0, -1);
+        }
+
+        /**
+         * Stops all threads.
+         */
+        void stop()
+        {
+            for (Thread &thread : threads)
+                thread.isActive = false;
+        }
+
+        /**
+         * Runs each thread until it yields or the instruction budget runs out.
+         */
+        void update() override
+        {
+            ScopedTimer timer(updateProfile);
+
+            uint32_t now = pros::millis();
+            int budget = INSTRUCTION_BUDGET;
+            for (int i = 0; i < MAX_THREADS && budget > 0; i++)
+            {
+                int threadID = (nextThread + i) % MAX_THREADS;
+                if (threads[threadID].isActive)
+                    _stepThread(threadID, now, budget);
+            }
+            nextThread = (nextThread + 1) % MAX_THREADS;
+        }
+
+        /**
+         * Checks if the script has finished.
+         * @return True if no threads are running, false otherwise.
+         */
+        bool isFinished()
+        {
+            for (Thread &thread : threads)
+                if (thread.isActive)
+                    return false;
+            return true;
+        }
+
+    private:
+        inline static ProfileSite updateProfile = ProfileSite("ScriptVM.update");
+
+        static constexpr int MAX_THREADS = 8;
+        static constexpr int INSTRUCTION_BUDGET = 64; // instructions per update
+
+        /**
+         * Represents the state of a single script thread.
+         */
+        struct Thread
+        {
+            /// @brief Whether the thread is running.
+            bool isActive = false;
+            /// @brief The index of the next instruction.
+            uint16_t pc = 0;
+            /// @brief The time to resume a `WAIT` at.
+            uint32_t wakeTime = 0;
+            /// @brief The thread that forked this thread, or -1 for the main thread.
+            int parent = -1;
+            /// @brief The number of forked threads that have not halted yet.
+            int childCount = 0;
+            /// @brief The loop counters of the thread.
+            std::array<int, ScriptProgram::MAX_LOOP_DEPTH> counters = {};
+        };
+
+        /**
+         * Starts a thread in a free slot.
+         * @param pc The instruction to start at.
+         * @param parent The thread that forked the new thread, or -1.
+         * @return True if there was a free slot, false otherwise.
+         */
+        bool _startThread(uint16_t pc, int parent)
+        {
+            for (Thread &thread : threads)
+            {
+                if (thread.isActive)
+                    continue;
+                thread = Thread();
+                thread.isActive = true;
+                thread.pc = pc;
+                thread.parent = parent;
+                if (parent >= 0)
+                    thread.counters = threads[parent].counters;
+                return true;
+            }
+            Logger::error("ScriptVM: Too many parallel branches");
+            return false;
+        }
+
+        /**
+         * Ends a thread and wakes its parent's `JOIN`.
+         * @param threadID The thread to end.
+         */
+        void _haltThread(int threadID)
+        {
+            Thread &thread = threads[threadID];
+            thread.isActive = false;
+            if (thread.parent >= 0)
+                threads[thread.parent].childCount--;
+        }
+
+        /**
+         * Runs a thread until it yields, halts, or the budget runs out.
+         * @param threadID The thread to run.
+         * @param now The current time in milliseconds.
+         * @param budget The remaining instruction budget. Decremented for each instruction.
+         */
+        void _stepThread(int threadID, uint32_t now, int &budget)
+        {
+            Thread &thread = threads[threadID];
+            if ((int32_t)(thread.wakeTime - now) > 0)
+                return;
+
+            while (budget > 0)
+            {
+                if (thread.pc >= program.code.size())
+                {
+                    _haltThread(threadID);
+                    return;
+                }
+
+                ScriptInstruction &instruction = program.code[thread.pc];
+                budget--;
+                switch (instruction.op)
+                {
+                case ScriptInstruction::HALT:
+                    _haltThread(threadID);
+                    return;
+                case ScriptInstruction::EVENT:
+                {
+                    // Every dispatch gets a new ID, so timers keyed by event ID restart on each pass through a loop
+                    PathEvent event = program.events[instruction.arg];
+                    event.id = std::rand();
+                    dispatcher.dispatch(event);
+                    thread.pc++;
+                    break;
+                }
+                case ScriptInstruction::WAIT:
+                    thread.wakeTime = now + (uint32_t)instruction.value;
+                    thread.pc++;
+                    return;
+                case ScriptInstruction::WAIT_UNTIL:
+                    if (!_evaluate(instruction))
+                        return;
+                    thread.pc++;
+                    break;
+                case ScriptInstruction::JUMP:
+                    thread.pc = instruction.arg;
+                    break;
+                case ScriptInstruction::JUMP_IF_NOT:
+                    thread.pc = _evaluate(instruction) ? thread.pc + 1 : instruction.arg;
+                    break;
+                case ScriptInstruction::LOOP_INIT:
+                    thread.counters[instruction.sensor] = (int)instruction.value;
+                    thread.pc++;
+                    break;
+                case ScriptInstruction::LOOP_NEXT:
+                    thread.pc = --thread.counters[instruction.sensor] > 0 ? instruction.arg : thread.pc + 1;
+                    break;
+                case ScriptInstruction::FORK:
+                    if (_startThread(instruction.arg, threadID))
+                        thread.childCount++;
+                    thread.pc++;
+                    break;
+                case ScriptInstruction::JOIN:
+                    if (thread.childCount > 0)
+                        return;
+                    thread.pc++;
+                    break;
+                }
+            }
+        }
+
+        /**
+         * Evaluates the condition of an instruction.
+         * @param instruction The instruction with the condition.
+         * @return True if the condition is met, false otherwise.
+         */
+        bool _evaluate(ScriptInstruction &instruction)
+        {
+            Sensor &sensor = sensors[instruction.sensor];
+            double reading = sensor ? sensor() : 0;
+            switch (instruction.compare)
+            {
+            case ScriptInstruction::GREATER:
+                return reading > instruction.value;
+            case ScriptInstruction::LESS:
+                return reading < instruction.value;
+            case ScriptInstruction::GREATER_EQUAL:
+                return reading >= instruction.value;
+            case ScriptInstruction::LESS_EQUAL:
+                return reading <= instruction.value;
+            case ScriptInstruction::EQUAL:
+                return reading == instruction.value;
+            case ScriptInstruction::NOT_EQUAL:
+                return reading != instruction.value;
+            }
+            return false;
+        }
+
+        EventDispatcher &dispatcher;
+        std::unordered_map<std::string, Sensor> sensorBindings;
+        ScriptProgram program;
+        std::vector<Sensor> sensors;
+        std::array<Thread, MAX_THREADS> threads;
+        int nextThread = 0;
+    };
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "logger.hpp"
+#include "../path/eventRegistry.hpp"
+#include "../path/pathFile.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Calls a handler for each active path event.
+     * Handlers are stored in a table indexed by the interned event name, so dispatching is an array lookup per event.
+     */
+    class EventDispatcher
+    {
+    public:
+        /**
+         * Represents a function that handles a path event.
+         */
+        typedef std::function<void(PathEvent &)> Handler;
+
+        /**
+         * Registers a handler for an event name. Replaces any existing handler for the name.
+         * @param name The name of the event (e.g. `intake`)
+         * @param handler The function to call while the event is active.
+         */
+        void on(std::string name, Handler handler)
+        {
+            int nameID = EventRegistry::intern(name);
+            if (nameID >= handlers.size())
+                handlers.resize(nameID + 1);
+            handlers[nameID] = handler;
+        }
+
+        /**
+         * Calls the handler of each event.
+         * Events without a handler are logged once per name.
+         * @param events The events to dispatch.
+         * @param isPaused Whether the robot is paused. Skips events marked with `afterPause`.
+         */
+        void dispatch(PathEvents &events, bool isPaused = false)
+        {
+            for (PathEvent &event : events)
+            {
+                // Post-Pause Events
+                if (event.isAfterPause && isPaused)
+                    continue;
+
+                dispatch(event);
+            }
+        }
+
+        /**
+         * Calls the handler of a single event.
+         * @param event The event to dispatch.
+         */
+        void dispatch(PathEvent &event)
+        {
+            if (event.nameID >= 0 && event.nameID < handlers.size() && handlers[event.nameID])
+                handlers[event.nameID](event);
+            else
+                _warnUnknown(event);
+        }
+
+        /**
+         * Logs an unknown event the first time it is dispatched.
+         * @param event The unknown event.
+         */
+        void _warnUnknown(PathEvent &event)
+        {
+            if (event.nameID < 0)
+                return;
+            if (event.nameID >= warnedEvents.size())
+                warnedEvents.resize(event.nameID + 1, false);
+            if (warnedEvents[event.nameID])
+                return;
+
+            warnedEvents[event.nameID] = true;
+            Logger::warn("Unknown Event: " + event.name);
+        }
+
+    private:
+        std::vector<Handler> handlers;
+        std::vector<bool> warnedEvents;
+    };
+}
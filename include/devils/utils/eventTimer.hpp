@@ -12,17 +12,19 @@ namespace devils
          * Starts the timer if the ID is not already running.
          * @param timerID The ID of the timer or event.
          * @param duration The duration of the timer in milliseconds.
+         * @return True if the timer was started, false if the ID was already started.
          */
-        void start(int timerID, double duration)
+        bool start(int timerID, double duration)
         {
             if (lastTimerID == timerID)
-                return;
+                return false;
             Logger::info("Starting Timer " + std::to_string(timerID) + "(from " + std::to_string(lastTimerID) + ")");
 
             lastTimerID = timerID;
             isRunning = true;
             startTime = pros::millis();
             this->duration = duration;
+            return true;
         }
 
         /**
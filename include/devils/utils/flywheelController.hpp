@@ -0,0 +1,315 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "logger.hpp"
+#include "loopRate.hpp"
+#include "runnable.hpp"
+#include "tuningFile.hpp"
+#include "../hardware/motor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace devils
+{
+    /**
+     * Controls the velocity of a flywheel using voltage feedforward and take-back-half.
+     * Runs in its own fixed-rate task and reads the motor velocity once per update.
+     * Shots are detected from dips in velocity to measure recovery time and fire rate.
+     */
+    class FlywheelController : public Runnable
+    {
+    public:
+        /**
+         * Creates a new flywheel controller.
+         * Tuned values are loaded from the `TuningFile` under `name + ".TBH"` if they exist.
+         * @param name The name of the flywheel (for logging and tuning purposes)
+         * @param motor The motor driving the flywheel.
+         * @param kV The voltage per RPM required to hold the flywheel at speed, from 0 to 1.
+         * @param tbhGain The gain of the take-back-half integrator, in voltage per RPM of error.
+         */
+        FlywheelController(std::string name, IMotor &motor, double kV, double tbhGain)
+            : name(name),
+              motor(motor),
+              kV(kV),
+              tbhGain(tbhGain)
+        {
+            std::vector<double> tunedValues = TuningFile::get(name + ".TBH");
+            if (tunedValues.size() >= 2)
+            {
+                this->kV = tunedValues[0];
+                this->tbhGain = tunedValues[1];
+                Logger::info(name + ": Loaded tuned feedforward");
+            }
+        }
+
+        /**
+         * Runs the flywheel loop at a fixed rate.
+         */
+        void runSync() override
+        {
+            LoopRate rate(name, UPDATE_PERIOD);
+            while (true)
+            {
+                update();
+                rate.wait();
+            }
+        }
+
+        /**
+         * Reads the flywheel velocity and updates the motor output.
+         */
+        void update() override
+        {
+            // Read Velocity
+            currentVelocity = motor.getVelocity();
+            uint32_t now = pros::millis();
+
+            // Abort if disabled
+            if (!isEnabled)
+            {
+                isAtSpeed = false;
+                return;
+            }
+
+            // Take-Back-Half
+            double error = setpoint - currentVelocity;
+            tbhOutput += tbhGain * error;
+            if ((error > 0) != (lastError > 0))
+            {
+                tbhOutput = (tbhOutput + tbhHold) * 0.5;
+                tbhHold = tbhOutput;
+            }
+            lastError = error;
+
+            // Feedforward
+            double output = std::clamp(kV * setpoint + tbhOutput, -1.0, 1.0);
+            motor.moveVoltage(output);
+
+            // Shot Detection
+            _updateShots(now);
+        }
+
+        /**
+         * Enables the controller at the given setpoint.
+         * @param setpoint The target velocity of the flywheel in RPM.
+         */
+        void setSetpoint(double setpoint)
+        {
+            if (!isEnabled || setpoint != this->setpoint)
+            {
+                tbhOutput = 0;
+                tbhHold = 0;
+                lastError = setpoint - currentVelocity;
+
+                // Spinning up to a new setpoint is not a shot
+                hasReachedSpeed = false;
+                isRecovering = false;
+            }
+            this->setpoint = setpoint;
+            isEnabled = true;
+        }
+
+        /**
+         * Disables the controller. Does not stop the motor.
+         */
+        void disable()
+        {
+            isEnabled = false;
+            isAtSpeed = false;
+            hasReachedSpeed = false;
+            isRecovering = false;
+        }
+
+        /**
+         * Measures the voltage feedforward by running the flywheel open-loop. Blocks until finished.
+         * The controller should be disabled while measuring.
+         * @param voltage The voltage to run the flywheel at, from -1 to 1.
+         * @return The measured voltage per RPM or 0 if the flywheel did not move.
+         */
+        double measureKV(double voltage)
+        {
+            // Spin Up
+            motor.moveVoltage(voltage);
+            pros::delay(KV_SPIN_UP_TIME);
+
+            // Average Velocity
+            double velocitySum = 0;
+            for (int i = 0; i < KV_SAMPLE_COUNT; i++)
+            {
+                velocitySum += currentVelocity;
+                pros::delay(UPDATE_PERIOD);
+            }
+            motor.stop();
+
+            double averageVelocity = velocitySum / KV_SAMPLE_COUNT;
+            if (std::abs(averageVelocity) < 1)
+            {
+                Logger::error(name + ": Flywheel did not spin while measuring kV");
+                return 0;
+            }
+            return voltage / averageVelocity;
+        }
+
+        /**
+         * Sets and saves the tuned values of the controller.
+         * @param kV The voltage per RPM required to hold the flywheel at speed.
+         * @param tbhGain The gain of the take-back-half integrator.
+         */
+        void setTuning(double kV, double tbhGain)
+        {
+            this->kV = kV;
+            this->tbhGain = tbhGain;
+            TuningFile::set(name + ".TBH", {kV, tbhGain});
+        }
+
+        /**
+         * Gets the voltage feedforward of the controller.
+         * @return The voltage per RPM required to hold the flywheel at speed.
+         */
+        double getKV()
+        {
+            return kV;
+        }
+
+        /**
+         * Gets the period of the control loop. Discrete gains must be scaled for this period.
+         * @return The period of the control loop in milliseconds.
+         */
+        uint32_t getUpdatePeriod()
+        {
+            return UPDATE_PERIOD;
+        }
+
+        /**
+         * Gets the velocity of the flywheel from the last update.
+         * @return The velocity of the flywheel in RPM.
+         */
+        double getVelocity()
+        {
+            return currentVelocity;
+        }
+
+        /**
+         * Gets the setpoint of the flywheel.
+         * @return The setpoint of the flywheel in RPM.
+         */
+        double getSetpoint()
+        {
+            return setpoint;
+        }
+
+        /**
+         * Checks if the flywheel is within range of the setpoint.
+         * @return True if the flywheel is at speed, false otherwise.
+         */
+        bool getAtSpeed()
+        {
+            return isAtSpeed;
+        }
+
+        /**
+         * Checks if the flywheel is recovering from a shot.
+         * @return True if the flywheel is recovering, false otherwise.
+         */
+        bool getRecovering()
+        {
+            return isRecovering;
+        }
+
+        /**
+         * Gets the number of shots detected since the controller was created.
+         * @return The number of shots detected.
+         */
+        int getShotCount()
+        {
+            return shotCount;
+        }
+
+        /**
+         * Gets the time it took the flywheel to return to speed after the last shot.
+         * @return The recovery time in milliseconds or 0 if no shot has recovered.
+         */
+        uint32_t getRecoveryTime()
+        {
+            return recoveryTime;
+        }
+
+        /**
+         * Gets the rate of fire over the last few shots.
+         * @return The number of shots per second or 0 if fewer than 2 shots have been detected.
+         */
+        double getShotsPerSecond()
+        {
+            int count = std::min(shotCount, SHOT_HISTORY_SIZE);
+            if (count < 2)
+                return 0;
+
+            uint32_t newestTime = shotTimes[(shotCount - 1) % SHOT_HISTORY_SIZE];
+            uint32_t oldestTime = shotTimes[(shotCount - count) % SHOT_HISTORY_SIZE];
+            if (newestTime == oldestTime)
+                return 0;
+            return (count - 1) * 1000.0 / (newestTime - oldestTime);
+        }
+
+        /**
+         * Updates the at-speed state and detects shots from dips in velocity.
+         * @param now The current time in milliseconds.
+         */
+        void _updateShots(uint32_t now)
+        {
+            // Speed in the direction of the setpoint
+            double direction = setpoint < 0 ? -1 : 1;
+            double speed = currentVelocity * direction;
+            double targetSpeed = setpoint * direction;
+
+            bool wasAtSpeed = isAtSpeed;
+            isAtSpeed = std::abs(speed - targetSpeed) < AT_SPEED_RANGE;
+
+            // Detect Shot
+            if (hasReachedSpeed && !isRecovering && speed < targetSpeed - SHOT_DIP_THRESHOLD)
+            {
+                shotTimes[shotCount % SHOT_HISTORY_SIZE] = now;
+                shotCount++;
+                isRecovering = true;
+            }
+
+            // Detect Recovery
+            if (isRecovering && isAtSpeed && !wasAtSpeed)
+            {
+                recoveryTime = now - shotTimes[(shotCount - 1) % SHOT_HISTORY_SIZE];
+                isRecovering = false;
+            }
+
+            hasReachedSpeed = hasReachedSpeed || isAtSpeed;
+        }
+
+    private:
+        static constexpr uint32_t UPDATE_PERIOD = 10;     // ms
+        static constexpr uint32_t KV_SPIN_UP_TIME = 3000; // ms
+        static constexpr int KV_SAMPLE_COUNT = 50;
+        static constexpr double AT_SPEED_RANGE = 15;      // RPM
+        static constexpr double SHOT_DIP_THRESHOLD = 25;  // RPM
+        static constexpr int SHOT_HISTORY_SIZE = 8;
+
+        std::string name;
+        IMotor &motor;
+        double kV;
+        double tbhGain;
+
+        // Control State
+        bool isEnabled = false;
+        double setpoint = 0;
+        double currentVelocity = 0;
+        double tbhOutput = 0;
+        double tbhHold = 0;
+        double lastError = 0;
+
+        // Shot State
+        bool isAtSpeed = false;
+        bool hasReachedSpeed = false;
+        bool isRecovering = false;
+        int shotCount = 0;
+        uint32_t recoveryTime = 0;
+        uint32_t shotTimes[SHOT_HISTORY_SIZE] = {};
+    };
+}
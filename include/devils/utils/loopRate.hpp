@@ -0,0 +1,92 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "logger.hpp"
+#include <string>
+
+namespace devils
+{
+    /**
+     * Paces a loop to a fixed period using absolute wake times.
+     * Unlike `pros::delay`, the time spent inside the loop does not add to the period.
+     * Iterations that finish after their deadline are counted as overruns and reported through the logger.
+     */
+    class LoopRate
+    {
+    public:
+        /**
+         * Creates a new loop rate.
+         * @param name The name of the loop (for logging purposes)
+         * @param period The period of the loop in milliseconds.
+         */
+        LoopRate(std::string name, uint32_t period)
+            : name(name),
+              period(period),
+              wakeTime(pros::millis())
+        {
+        }
+
+        /**
+         * Sleeps until the start of the next period.
+         * If the deadline was already missed, the loop is re-phased to the current time instead of bursting to catch up.
+         */
+        void wait()
+        {
+            uint32_t now = pros::millis();
+            if (now - wakeTime > period)
+            {
+                _onOverrun(now);
+                wakeTime = now;
+            }
+            pros::Task::delay_until(&wakeTime, period);
+        }
+
+        /**
+         * Re-phases the loop to start at the current time.
+         */
+        void reset()
+        {
+            wakeTime = pros::millis();
+        }
+
+        /**
+         * Gets the period of the loop.
+         * @return The period of the loop in milliseconds.
+         */
+        uint32_t getPeriod()
+        {
+            return period;
+        }
+
+        /**
+         * Gets the number of iterations that missed their deadline.
+         * @return The number of overruns since the loop was created.
+         */
+        int getOverrunCount()
+        {
+            return overrunCount;
+        }
+
+        /**
+         * Counts an overrun and logs it, at most once per `OVERRUN_LOG_INTERVAL`.
+         * @param now The current time in milliseconds.
+         */
+        void _onOverrun(uint32_t now)
+        {
+            overrunCount++;
+            if (lastLogTime >= 0 && now - lastLogTime < OVERRUN_LOG_INTERVAL)
+                return;
+
+            Logger::warn(name + ": Missed " + std::to_string(overrunCount) + " deadline(s) of " + std::to_string(period) + "ms");
+            lastLogTime = now;
+        }
+
+    private:
+        static constexpr uint32_t OVERRUN_LOG_INTERVAL = 5000; // ms
+
+        std::string name;
+        uint32_t period;
+        uint32_t wakeTime;
+        int overrunCount = 0;
+        int64_t lastLogTime = -1;
+    };
+}
@@ -1,10 +1,25 @@
 #pragma once
 #include "pros/rtos.hpp"
 #include "../utils/logger.hpp"
+#include <algorithm>
+#include <cmath>
 #include <ctime>
 
 namespace devils
 {
+    /**
+     * Represents a set of PID gains.
+     */
+    struct PIDGains
+    {
+        /// @brief The proportional constant.
+        double p = 0;
+        /// @brief The integral constant.
+        double i = 0;
+        /// @brief The derivative constant.
+        double d = 0;
+    };
+
     /**
      * Represents a simple PID controller.
      */
@@ -25,7 +40,7 @@ namespace devils
               iGain(iGain),
               dGain(dGain),
               maxIntegral(maxIntegral),
-              maxError(maxIntegral / iGain)
+              maxError(_getMaxError(maxIntegral, iGain))
         {
         }
 
@@ -60,6 +75,27 @@ namespace devils
             return output;
         }
 
+        /**
+         * Sets the gains of the PID controller.
+         * @param gains The new proportional, integral, and derivative constants.
+         */
+        void setGains(PIDGains gains)
+        {
+            pGain = gains.p;
+            iGain = gains.i;
+            dGain = gains.d;
+            maxError = _getMaxError(maxIntegral, iGain);
+        }
+
+        /**
+         * Gets the gains of the PID controller.
+         * @return The proportional, integral, and derivative constants.
+         */
+        PIDGains getGains()
+        {
+            return PIDGains{pGain, iGain, dGain};
+        }
+
         /**
          * Sets the maximum output of the PID controller.
          * @param maxOutput The maximum output of the PID controller.
@@ -75,12 +111,25 @@ namespace devils
             lastActual = 0;
         }
 
+        /**
+         * Gets the largest error sum that stays within the integral limit.
+         * @param maxIntegral The maximum integral output.
+         * @param iGain The integral constant.
+         * @return The maximum absolute error sum, or 0 for a P or PD controller so nothing accumulates.
+         */
+        static double _getMaxError(double maxIntegral, double iGain)
+        {
+            if (iGain == 0)
+                return 0;
+            return std::abs(maxIntegral / iGain);
+        }
+
     private:
-        const double pGain;
-        const double iGain;
-        const double dGain;
+        double pGain;
+        double iGain;
+        double dGain;
         const double maxIntegral = 1;
-        const double maxError = 1;
+        double maxError = 1;
 
         double setpoint = 0;
         double errorSum = 0;
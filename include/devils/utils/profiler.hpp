@@ -0,0 +1,252 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "logger.hpp"
+#include "../hardware/sdCard.hpp"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Records the execution time of a named section of code in a fixed-bucket histogram.
+     * Buckets are spaced logarithmically with 4 linear sub-buckets per power of 2,
+     * so percentiles are accurate to within 25% without allocating.
+     */
+    class ProfileSite
+    {
+    public:
+        /**
+         * Creates a new profile site and registers it with the `Profiler`.
+         * Sites should be declared as static members so they are only registered once.
+         * @param name The name of the site (e.g. `PursuitController.update`)
+         */
+        ProfileSite(std::string name)
+            : name(name)
+        {
+            _getSites().push_back(this);
+        }
+
+        /**
+         * Records a single sample.
+         * @param duration The duration of the sample in microseconds.
+         */
+        void record(uint32_t duration)
+        {
+            buckets[_getBucketIndex(duration)]++;
+            count++;
+            maxDuration = std::max(maxDuration, duration);
+        }
+
+        /**
+         * Clears all recorded samples.
+         */
+        void reset()
+        {
+            std::fill(std::begin(buckets), std::end(buckets), 0);
+            count = 0;
+            maxDuration = 0;
+        }
+
+        /**
+         * Gets an upper bound of a percentile of the recorded samples.
+         * @param percentile The percentile to get, from 0 to 1.
+         * @return The duration in microseconds or 0 if no samples have been recorded.
+         */
+        uint32_t getPercentile(double percentile)
+        {
+            if (count == 0)
+                return 0;
+
+            uint32_t targetCount = std::max((uint32_t)(percentile * count), (uint32_t)1);
+            uint32_t cumulativeCount = 0;
+            for (int i = 0; i < BUCKET_COUNT; i++)
+            {
+                cumulativeCount += buckets[i];
+                if (cumulativeCount >= targetCount)
+                    return std::min(_getBucketLowerBound(i + 1), maxDuration);
+            }
+            return maxDuration;
+        }
+
+        /**
+         * Gets the longest recorded sample.
+         * @return The duration in microseconds.
+         */
+        uint32_t getMax()
+        {
+            return maxDuration;
+        }
+
+        /**
+         * Gets the number of recorded samples.
+         * @return The number of samples.
+         */
+        uint32_t getCount()
+        {
+            return count;
+        }
+
+        /**
+         * Gets the name of the site.
+         * @return The name of the site.
+         */
+        std::string getName()
+        {
+            return name;
+        }
+
+        /**
+         * Gets the bucket a duration falls into.
+         * @param duration The duration in microseconds.
+         * @return The index of the bucket.
+         */
+        static int _getBucketIndex(uint32_t duration)
+        {
+            if (duration < 4)
+                return duration;
+
+            int exponent = 31 - __builtin_clz(duration);
+            int subBucket = (duration >> (exponent - 2)) & 3;
+            return std::min(4 * (exponent - 1) + subBucket, BUCKET_COUNT - 1);
+        }
+
+        /**
+         * Gets the smallest duration that falls into a bucket.
+         * @param index The index of the bucket.
+         * @return The duration in microseconds.
+         */
+        static uint32_t _getBucketLowerBound(int index)
+        {
+            if (index < 4)
+                return index;
+
+            int exponent = index / 4 + 1;
+            int subBucket = index % 4;
+            return (uint32_t)(4 + subBucket) << (exponent - 2);
+        }
+
+        /**
+         * Gets all registered sites.
+         * Stored as a function-local static so sites declared in other static members can register safely.
+         * @return A reference to the list of sites.
+         */
+        static std::vector<ProfileSite *> &_getSites()
+        {
+            static std::vector<ProfileSite *> sites;
+            return sites;
+        }
+
+    private:
+        static constexpr int BUCKET_COUNT = 64; // up to ~115ms
+
+        std::string name;
+        uint32_t buckets[BUCKET_COUNT] = {};
+        uint32_t count = 0;
+        uint32_t maxDuration = 0;
+    };
+
+    /**
+     * Collects and reports all registered `ProfileSite`s.
+     */
+    class Profiler
+    {
+    public:
+        /// @brief Set to false to remove all profiling at compile time.
+        static constexpr bool ENABLED = true;
+
+        /**
+         * Serializes the p50, p99 and max of each site into a string.
+         * @return The profile as a string.
+         */
+        static std::string serialize()
+        {
+            std::stringstream stream;
+            stream << "PROFILE 1\n";
+            for (ProfileSite *site : ProfileSite::_getSites())
+            {
+                stream << "SITE " << site->getName()
+                       << " " << site->getCount()
+                       << " " << site->getPercentile(0.5)
+                       << " " << site->getPercentile(0.99)
+                       << " " << site->getMax() << "\n";
+            }
+            stream << "ENDPROFILE\n";
+            return stream.str();
+        }
+
+        /**
+         * Logs the p50, p99 and max of each site.
+         */
+        static void log()
+        {
+            for (ProfileSite *site : ProfileSite::_getSites())
+            {
+                if (site->getCount() == 0)
+                    continue;
+                Logger::info("Profiler: " + site->getName() +
+                             " p50=" + std::to_string(site->getPercentile(0.5)) + "us" +
+                             " p99=" + std::to_string(site->getPercentile(0.99)) + "us" +
+                             " max=" + std::to_string(site->getMax()) + "us");
+            }
+        }
+
+        /**
+         * Saves the profile to the SD card.
+         * Does nothing if profiling is disabled or the SD card is not inserted.
+         */
+        static void saveToSD()
+        {
+            if (!ENABLED || !SDCard::isInserted())
+                return;
+            SDCard::writeFromString(PROFILE_FILE_PATH, serialize());
+        }
+
+        /**
+         * Clears all recorded samples from every site.
+         */
+        static void reset()
+        {
+            for (ProfileSite *site : ProfileSite::_getSites())
+                site->reset();
+        }
+
+    private:
+        Profiler() = delete;
+
+        inline static const std::string PROFILE_FILE_PATH = "profile.txt";
+    };
+
+    /**
+     * Times the enclosing scope and records it to a `ProfileSite`.
+     * Compiles to nothing when `Profiler::ENABLED` is false.
+     */
+    class ScopedTimer
+    {
+    public:
+        /**
+         * Starts timing the enclosing scope.
+         * @param site The site to record to.
+         */
+        ScopedTimer(ProfileSite &site)
+            : site(site)
+        {
+            if constexpr (Profiler::ENABLED)
+                startTime = pros::micros();
+        }
+
+        /**
+         * Records the time since the timer was created.
+         */
+        ~ScopedTimer()
+        {
+            if constexpr (Profiler::ENABLED)
+                site.record(pros::micros() - startTime);
+        }
+
+    private:
+        ProfileSite &site;
+        uint64_t startTime = 0;
+    };
+}
@@ -0,0 +1,267 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "logger.hpp"
+#include "pid.hpp"
+#include "../hardware/motor.hpp"
+#include "../chassis/chassis.hpp"
+#include "../odom/odomSource.hpp"
+#include "../geometry/units.hpp"
+#include <cmath>
+#include <optional>
+
+namespace devils
+{
+    /**
+     * Automatically tunes PID gains using the Åström–Hägglund relay method.
+     * The output is switched between `bias ± amplitude` until the system settles into a steady oscillation.
+     * The ultimate gain and period of the oscillation are then converted to gains using Ziegler–Nichols.
+     */
+    class RelayTuner
+    {
+    public:
+        /**
+         * Creates a new relay tuner.
+         * @param amplitude The amplitude of the relay output, from 0 to 1.
+         * @param bias The output the relay oscillates around, from -1 to 1.
+         * @param hysteresis The error band where the relay does not switch. Prevents noise from switching the relay.
+         */
+        RelayTuner(double amplitude, double bias = 0, double hysteresis = 0)
+            : amplitude(amplitude),
+              bias(bias),
+              hysteresis(hysteresis)
+        {
+        }
+
+        /**
+         * Resets the tuner to its initial state.
+         */
+        void reset()
+        {
+            isRelayHigh = true;
+            cycleCount = 0;
+            lastRiseTime = -1;
+            periodSum = 0;
+            amplitudeSum = 0;
+            maxMeasurement = -INFINITY;
+            minMeasurement = INFINITY;
+        }
+
+        /**
+         * Updates the relay with the latest measurement.
+         * @param measurement The current value of the system.
+         * @param setpoint The value to oscillate around.
+         * @return The output to apply to the system, from -1 to 1.
+         */
+        double update(double measurement, double setpoint)
+        {
+            double error = setpoint - measurement;
+            maxMeasurement = std::max(maxMeasurement, measurement);
+            minMeasurement = std::min(minMeasurement, measurement);
+
+            // Switch Relay
+            if (!isRelayHigh && error > hysteresis)
+            {
+                isRelayHigh = true;
+                _onRise();
+            }
+            else if (isRelayHigh && error < -hysteresis)
+            {
+                isRelayHigh = false;
+            }
+
+            return std::clamp(bias + (isRelayHigh ? amplitude : -amplitude), -1.0, 1.0);
+        }
+
+        /**
+         * Checks if enough oscillations have been recorded to calculate gains.
+         * @return True if the tuner is finished, false otherwise.
+         */
+        bool isFinished()
+        {
+            return cycleCount > TRANSIENT_CYCLES + MEASURED_CYCLES;
+        }
+
+        /**
+         * Gets the ultimate gain of the system. Only valid once `isFinished` is true.
+         * @return The ultimate gain of the system.
+         */
+        double getUltimateGain()
+        {
+            double oscillation = amplitudeSum / MEASURED_CYCLES;
+            if (oscillation <= 0)
+                return 0;
+            return (4 * amplitude) / (M_PI * oscillation);
+        }
+
+        /**
+         * Gets the ultimate period of the system. Only valid once `isFinished` is true.
+         * @return The ultimate period of the system in milliseconds.
+         */
+        double getUltimatePeriod()
+        {
+            return periodSum / MEASURED_CYCLES;
+        }
+
+        /**
+         * Calculates gains using the Ziegler–Nichols rules.
+         * Gains are scaled for the `PID` class, which integrates and differentiates once per update.
+         * @param loopPeriod The period of the PID update loop in milliseconds.
+         * @param usePI True to calculate PI gains, false to calculate PID gains.
+         * @return The calculated gains.
+         */
+        PIDGains getGains(double loopPeriod, bool usePI = false)
+        {
+            double ultimateGain = getUltimateGain();
+            double ultimatePeriod = getUltimatePeriod() / 1000.0;
+            double dt = loopPeriod / 1000.0;
+            if (ultimatePeriod <= 0)
+                return PIDGains{0, 0, 0};
+
+            // Continuous Gains
+            double p = usePI ? 0.45 * ultimateGain : 0.6 * ultimateGain;
+            double i = usePI ? p * 1.2 / ultimatePeriod : p * 2 / ultimatePeriod;
+            double d = usePI ? 0 : p * ultimatePeriod / 8;
+
+            // Discrete Gains
+            return PIDGains{p, i * dt, d / dt};
+        }
+
+        /**
+         * Tunes the velocity of a motor. Blocks until finished or timed out.
+         * @param motor The motor to tune.
+         * @param setpoint The velocity to oscillate around in RPM.
+         * @param bias The voltage that roughly holds the motor at `setpoint`, from -1 to 1.
+         * @param amplitude The amplitude of the relay output, from 0 to 1.
+         * @param usePI True to calculate PI gains, false to calculate PID gains.
+         * @param controlPeriod The period of the loop that will use the gains in milliseconds.
+         *                      Defaults to the tuner's own loop period.
+         * @return The tuned gains or `nullopt` if the tuner timed out.
+         */
+        static std::optional<PIDGains> tuneVelocity(IMotor &motor, double setpoint, double bias, double amplitude,
+                                                    bool usePI = true, double controlPeriod = LOOP_PERIOD)
+        {
+            RelayTuner tuner(amplitude, bias, std::abs(setpoint) * VELOCITY_HYSTERESIS);
+            bool isTuned = tuner._run([&]()
+                                      { motor.moveVoltage(tuner.update(motor.getVelocity(), setpoint)); });
+            motor.stop();
+            if (!isTuned)
+                return std::nullopt;
+            return tuner.getGains(controlPeriod, usePI);
+        }
+
+        /**
+         * Tunes the rotation of a chassis around its current heading. Blocks until finished or timed out.
+         * @param chassis The chassis to tune.
+         * @param odometry The odometry source to measure the heading from.
+         * @param amplitude The amplitude of the relay output, from 0 to 1.
+         * @return The tuned gains or `nullopt` if the tuner timed out.
+         */
+        static std::optional<PIDGains> tuneRotation(BaseChassis &chassis, OdomSource &odometry, double amplitude)
+        {
+            RelayTuner tuner(amplitude, 0, ROTATION_HYSTERESIS);
+            double startRotation = odometry.getSnapshot().getPose().rotation;
+            bool isTuned = tuner._run([&]()
+                                      {
+                                          double error = Units::diffRad(odometry.getSnapshot().getPose().rotation, startRotation);
+                                          chassis.move(0, tuner.update(error, 0)); });
+            chassis.stop();
+            if (!isTuned)
+                return std::nullopt;
+            return tuner.getGains(LOOP_PERIOD);
+        }
+
+        /**
+         * Tunes the forward translation of a chassis around its current position. Blocks until finished or timed out.
+         * @param chassis The chassis to tune.
+         * @param odometry The odometry source to measure the position from.
+         * @param amplitude The amplitude of the relay output, from 0 to 1.
+         * @return The tuned gains or `nullopt` if the tuner timed out.
+         */
+        static std::optional<PIDGains> tuneTranslation(BaseChassis &chassis, OdomSource &odometry, double amplitude)
+        {
+            RelayTuner tuner(amplitude, 0, TRANSLATION_HYSTERESIS);
+            Pose startPose = odometry.getSnapshot().getPose();
+            bool isTuned = tuner._run([&]()
+                                      {
+                                          Pose currentPose = odometry.getSnapshot().getPose();
+                                          double deltaX = currentPose.x - startPose.x;
+                                          double deltaY = currentPose.y - startPose.y;
+                                          double distance = std::cos(startPose.rotation) * deltaX + std::sin(startPose.rotation) * deltaY;
+                                          chassis.move(tuner.update(distance, 0), 0); });
+            chassis.stop();
+            if (!isTuned)
+                return std::nullopt;
+            return tuner.getGains(LOOP_PERIOD);
+        }
+
+        /**
+         * Runs a step function at a fixed rate until the tuner finishes or times out.
+         * @param step The function to run each loop.
+         * @return True if the tuner finished, false if it timed out.
+         */
+        template <typename T>
+        bool _run(T step)
+        {
+            reset();
+            uint32_t startTime = pros::millis();
+            uint32_t wakeTime = startTime;
+            while (!isFinished())
+            {
+                if (pros::millis() - startTime > TIMEOUT)
+                {
+                    Logger::error("RelayTuner: Timed out before the system oscillated");
+                    return false;
+                }
+                step();
+                pros::Task::delay_until(&wakeTime, LOOP_PERIOD);
+            }
+
+            Logger::info("RelayTuner: Ku=" + std::to_string(getUltimateGain()) + " Tu=" + std::to_string(getUltimatePeriod()) + "ms");
+            return true;
+        }
+
+        /**
+         * Called when the relay switches from low to high. Marks the end of a full cycle.
+         */
+        void _onRise()
+        {
+            uint32_t now = pros::millis();
+            if (lastRiseTime >= 0)
+            {
+                cycleCount++;
+
+                // Record cycles after the transient has died out
+                if (cycleCount > TRANSIENT_CYCLES && cycleCount <= TRANSIENT_CYCLES + MEASURED_CYCLES)
+                {
+                    periodSum += now - lastRiseTime;
+                    amplitudeSum += (maxMeasurement - minMeasurement) / 2;
+                }
+            }
+
+            lastRiseTime = now;
+            maxMeasurement = -INFINITY;
+            minMeasurement = INFINITY;
+        }
+
+    private:
+        static constexpr uint32_t LOOP_PERIOD = 20;           // ms
+        static constexpr uint32_t TIMEOUT = 15000;            // ms
+        static constexpr double VELOCITY_HYSTERESIS = 0.02;   // % of setpoint
+        static constexpr double ROTATION_HYSTERESIS = 0.01;   // rad
+        static constexpr double TRANSLATION_HYSTERESIS = 0.1; // in
+        static constexpr int TRANSIENT_CYCLES = 2;
+        static constexpr int MEASURED_CYCLES = 4;
+
+        double amplitude;
+        double bias;
+        double hysteresis;
+
+        bool isRelayHigh = true;
+        int cycleCount = 0;
+        double lastRiseTime = -1;
+        double periodSum = 0;
+        double amplitudeSum = 0;
+        double maxMeasurement = -INFINITY;
+        double minMeasurement = INFINITY;
+    };
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "pros/rtos.hpp"
+#include "loopRate.hpp"
 
 namespace devils
 {
@@ -14,14 +15,15 @@ namespace devils
         virtual void update() = 0;
 
         /**
-         * Runs the object synchronously.
+         * Runs the object synchronously at a fixed 20ms period.
          */
         virtual void runSync()
         {
+            LoopRate rate("Runnable", 20);
             while (true)
             {
                 update();
-                pros::delay(20);
+                rate.wait();
             }
         }
 
@@ -0,0 +1,118 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include "logger.hpp"
+#include "loopRate.hpp"
+#include "runnable.hpp"
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Runs registered `Runnable`s at fixed periods, each in its own task.
+     * Priorities are assigned rate-monotonically, so runnables with shorter periods preempt those with longer periods.
+     * All scheduled tasks run above the default priority used by the competition tasks.
+     */
+    class Scheduler
+    {
+    public:
+        /**
+         * Registers a runnable with the scheduler. Must be called before `start`.
+         * @param runnable The runnable to run.
+         * @param name The name of the runnable (for logging purposes)
+         * @param period The period to run the runnable at in milliseconds.
+         */
+        void add(Runnable &runnable, std::string name, uint32_t period)
+        {
+            if (isStarted)
+            {
+                Logger::error("Scheduler: Cannot add " + name + " after the scheduler has started");
+                return;
+            }
+            entries.push_back(Entry{&runnable, LoopRate(name, period)});
+        }
+
+        /**
+         * Starts a task for each registered runnable.
+         */
+        void start()
+        {
+            if (isStarted)
+                return;
+            isStarted = true;
+
+            for (Entry &entry : entries)
+            {
+                Entry *entryPtr = &entry;
+                pros::Task([=]
+                           { _runEntry(entryPtr); },
+                           _getPriority(entry.rate.getPeriod()));
+            }
+        }
+
+        /**
+         * Gets the total number of missed deadlines across all runnables.
+         * @return The total number of overruns.
+         */
+        int getOverrunCount()
+        {
+            int count = 0;
+            for (Entry &entry : entries)
+                count += entry.rate.getOverrunCount();
+            return count;
+        }
+
+    private:
+        /**
+         * Represents a runnable registered with the scheduler.
+         */
+        struct Entry
+        {
+            Runnable *runnable;
+            LoopRate rate;
+        };
+
+        /**
+         * Runs a single entry forever at its period.
+         * @param entry The entry to run.
+         */
+        static void _runEntry(Entry *entry)
+        {
+            entry->rate.reset();
+            while (true)
+            {
+                entry->runnable->update();
+                entry->rate.wait();
+            }
+        }
+
+        /**
+         * Gets the rate-monotonic priority of a period.
+         * Each distinct period shorter than `period` lowers the priority by one.
+         * @param period The period in milliseconds.
+         * @return The PROS task priority.
+         */
+        uint32_t _getPriority(uint32_t period)
+        {
+            // Count distinct faster periods
+            std::vector<uint32_t> fasterPeriods;
+            for (Entry &entry : entries)
+            {
+                uint32_t otherPeriod = entry.rate.getPeriod();
+                if (otherPeriod < period && std::find(fasterPeriods.begin(), fasterPeriods.end(), otherPeriod) == fasterPeriods.end())
+                    fasterPeriods.push_back(otherPeriod);
+            }
+
+            int priority = MAX_PRIORITY - (int)fasterPeriods.size();
+            return std::max(priority, MIN_PRIORITY);
+        }
+
+        static constexpr int MAX_PRIORITY = TASK_PRIORITY_MAX - 2;
+        static constexpr int MIN_PRIORITY = TASK_PRIORITY_DEFAULT + 1;
+
+        std::deque<Entry> entries;
+        bool isStarted = false;
+    };
+}
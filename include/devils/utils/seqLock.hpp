@@ -0,0 +1,79 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace devils
+{
+    /**
+     * Publishes a value from one writer task to any number of reader tasks without locking.
+     *
+     * The writer alternates between two slots, each guarded by a sequence counter, and publishes the slot index once written.
+     * Readers copy the published slot and retry if the writer started overwriting it mid-copy.
+     * Readers never wait on a preempted writer, since the writer is always writing the slot that is not published.
+     *
+     * @tparam T The value type. Must be trivially copyable.
+     */
+    template <typename T>
+    class SeqLock
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "SeqLock values must be trivially copyable");
+
+    public:
+        /**
+         * Publishes a new value. Must only be called from a single writer task.
+         * @param value The value to publish.
+         */
+        void write(const T &value)
+        {
+            int index = 1 - published.load(std::memory_order_relaxed);
+            Slot &slot = slots[index];
+
+            // Odd sequence marks the slot as being written
+            uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+            slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::memcpy(&slot.value, &value, sizeof(T));
+
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.sequence.store(sequence + 2, std::memory_order_relaxed);
+            published.store(index, std::memory_order_release);
+        }
+
+        /**
+         * Reads the last published value. Safe to call from any task.
+         * @return A consistent copy of the last published value.
+         */
+        T read() const
+        {
+            T value;
+            while (true)
+            {
+                int index = published.load(std::memory_order_acquire);
+                const Slot &slot = slots[index];
+
+                uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence % 2 != 0)
+                    continue;
+
+                std::memcpy(&value, &slot.value, sizeof(T));
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+                    return value;
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<uint32_t> sequence = 0;
+            T value = T();
+        };
+
+        Slot slots[2];
+        std::atomic<int> published = 0;
+    };
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include "logger.hpp"
+#include "pid.hpp"
+#include "stringUtils.hpp"
+#include "../hardware/sdCard.hpp"
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace devils
+{
+    /**
+     * Reads and writes tuned constants to the SD card.
+     * Values are cached after the first read, so lookups are cheap after startup.
+     */
+    class TuningFile
+    {
+    public:
+        /**
+         * Gets a set of tuned values from the tuning file.
+         * @param key The name of the values (e.g. `Blaze.Launcher.LeftFlywheel`)
+         * @return The tuned values or an empty vector if the key does not exist.
+         */
+        static std::vector<double> get(std::string key)
+        {
+            _load();
+            auto entry = values.find(key);
+            if (entry == values.end())
+                return {};
+            return entry->second;
+        }
+
+        /**
+         * Sets a set of tuned values and saves the tuning file to the SD card.
+         * @param key The name of the values (e.g. `Blaze.Launcher.LeftFlywheel`)
+         * @param newValues The values to save.
+         */
+        static void set(std::string key, std::vector<double> newValues)
+        {
+            _load();
+            values[key] = newValues;
+            SDCard::writeFromString(TUNING_FILE_PATH, serialize());
+        }
+
+        /**
+         * Applies tuned gains to a PID controller if they exist in the tuning file.
+         * @param key The name of the gains.
+         * @param pid The PID controller to apply the gains to.
+         * @return True if the gains were found and applied, false otherwise.
+         */
+        static bool loadPID(std::string key, PID &pid)
+        {
+            std::vector<double> gains = get(key);
+            if (gains.size() < 3)
+                return false;
+
+            pid.setGains(PIDGains{gains[0], gains[1], gains[2]});
+            Logger::info("TuningFile: Loaded " + key);
+            return true;
+        }
+
+        /**
+         * Saves PID gains to the tuning file.
+         * @param key The name of the gains.
+         * @param gains The gains to save.
+         */
+        static void savePID(std::string key, PIDGains gains)
+        {
+            set(key, {gains.p, gains.i, gains.d});
+        }
+
+        /**
+         * Serializes all the tuned values into a string.
+         * @return The tuning file as a string.
+         */
+        static std::string serialize()
+        {
+            std::stringstream stream;
+            stream << "TUNING 1\n";
+            for (auto &entry : values)
+            {
+                stream << "VALUE " << entry.first;
+                for (double value : entry.second)
+                    stream << " " << value;
+                stream << "\n";
+            }
+            stream << "ENDTUNING\n";
+            return stream.str();
+        }
+
+        /**
+         * Deserializes tuned values from a string into the cache.
+         * @param data The data to deserialize.
+         */
+        static void deserialize(std::string data)
+        {
+            // Read from string
+            std::string line;
+            std::istringstream readStream(data);
+
+            // Iterate through each line
+            while (std::getline(readStream, line))
+            {
+                if (line.empty())
+                    continue;
+                if (line.rfind("ENDTUNING") == 0)
+                    break;
+                if (line.rfind("TUNING 1") == 0)
+                    continue;
+                if (line.rfind("VALUE") == 0)
+                    _parseValue(line);
+            }
+        }
+
+        /**
+         * Parses a value from a line in the tuning file.
+         * @param line The line to parse.
+         */
+        static void _parseValue(std::string line)
+        {
+            // Strip carriage returns
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            // Split the line into properties
+            auto split = StringUtils::split(line, ' ');
+            if (split.size() < 3)
+                return;
+
+            // Parse Values
+            // Skip the whole entry on bad input so the compiled-in values are used instead
+            std::vector<double> parsedValues;
+            try
+            {
+                for (int i = 2; i < split.size(); i++)
+                    parsedValues.push_back(std::stod(split[i]));
+            }
+            catch (const std::exception &e)
+            {
+                Logger::error("TuningFile: Invalid value for " + split[1] + ": " + line);
+                return;
+            }
+            values[split[1]] = parsedValues;
+        }
+
+        /**
+         * Reads the tuning file from the SD card if it hasn't been read yet.
+         */
+        static void _load()
+        {
+            if (isLoaded)
+                return;
+            isLoaded = true;
+
+            if (SDCard::isInserted())
+                deserialize(SDCard::readToString(TUNING_FILE_PATH));
+        }
+
+    private:
+        TuningFile() = delete;
+
+        inline static const std::string TUNING_FILE_PATH = "tuning.txt";
+
+        inline static bool isLoaded = false;
+        inline static std::map<std::string, std::vector<double>> values = {};
+    };
+}
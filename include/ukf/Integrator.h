@@ -23,7 +23,7 @@ SOFTWARE.
 #ifndef INTEGRATOR_H_
 #define INTEGRATOR_H_
 
-#include "UKF/Config.h"
+#include "Config.h"
 
 namespace UKF {
 
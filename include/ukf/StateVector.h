@@ -0,0 +1,438 @@
+/*
+Copyright (C) 2016 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef STATEVECTOR_H
+#define STATEVECTOR_H
+
+#include <array>
+#include <limits>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include "Types.h"
+
+namespace UKF {
+
+/*
+A field in a state or measurement vector. The key is used to look the field
+up, and the type determines how the field is stored and combined. Supported
+types are real_t, Vector<N>, FieldVector and Quaternion.
+*/
+template <int Key, typename T>
+class Field {
+public:
+    using type = T;
+    static constexpr int key = Key;
+};
+
+/*
+Sigma point and attitude parameters. These are variable templates, so they
+can be specialised for an individual StateVector type.
+*/
+namespace Parameters {
+
+/* Sigma point spread parameters. See the Kraft paper, section 3.1. */
+template <typename T> constexpr real_t AlphaSquared = real_t(1.0);
+template <typename T> constexpr real_t Beta = real_t(0.0);
+template <typename T> constexpr real_t Kappa = real_t(3.0);
+
+template <typename T> constexpr real_t Lambda =
+    AlphaSquared<T> * (T::covariance_size() + Kappa<T>) - T::covariance_size();
+
+/* Sigma point weights for the mean and covariance. */
+template <typename T> constexpr real_t Sigma_WM0 = Lambda<T> / (T::covariance_size() + Lambda<T>);
+template <typename T> constexpr real_t Sigma_WC0 = Sigma_WM0<T> + (real_t(1.0) - AlphaSquared<T> + Beta<T>);
+template <typename T> constexpr real_t Sigma_WMI = real_t(1.0) / (real_t(2.0) * (T::covariance_size() + Lambda<T>));
+template <typename T> constexpr real_t Sigma_WCI = Sigma_WMI<T>;
+
+/*
+Modified Rodrigues parameter constants, as used in the Crassidis and Markley
+paper. A = 0 and F = 2(A + 1) gives the standard MRP representation.
+*/
+template <typename T> constexpr real_t MRP_A = real_t(0.0);
+template <typename T> constexpr real_t MRP_F = real_t(2.0) * (MRP_A<T> + real_t(1.0));
+
+}
+
+namespace Detail {
+
+/* Number of values used to store a field in a state or measurement vector. */
+template <typename T> constexpr std::size_t StateVectorDimension = T::RowsAtCompileTime;
+template <> constexpr std::size_t StateVectorDimension<real_t> = 1;
+template <> constexpr std::size_t StateVectorDimension<Quaternion> = 4;
+
+/*
+Number of values used to store the covariance of a field. Quaternions are
+stored with four values, but only have three degrees of freedom.
+*/
+template <typename T> constexpr std::size_t CovarianceDimension = T::RowsAtCompileTime;
+template <> constexpr std::size_t CovarianceDimension<real_t> = 1;
+template <> constexpr std::size_t CovarianceDimension<Quaternion> = 3;
+
+/* Total size of a set of field types. */
+template <typename... Types>
+constexpr std::size_t get_composite_vector_dimension() {
+    return (std::size_t(0) + ... + StateVectorDimension<Types>);
+}
+
+template <typename... Types>
+constexpr std::size_t get_covariance_dimension() {
+    return (std::size_t(0) + ... + CovarianceDimension<Types>);
+}
+
+/*
+Field lookup by key. Each function returns the maximum value of std::size_t
+if the key is not present, so callers can static_assert on it.
+*/
+template <typename... Fields>
+constexpr std::size_t get_field_size(int Key) {
+    constexpr int keys[] = {Fields::key...};
+    constexpr std::size_t sizes[] = {StateVectorDimension<typename Fields::type>...};
+    for(std::size_t i = 0; i < sizeof...(Fields); i++) {
+        if(keys[i] == Key) {
+            return sizes[i];
+        }
+    }
+    return std::numeric_limits<std::size_t>::max();
+}
+
+template <typename... Fields>
+constexpr std::size_t get_field_covariance_size(int Key) {
+    constexpr int keys[] = {Fields::key...};
+    constexpr std::size_t sizes[] = {CovarianceDimension<typename Fields::type>...};
+    for(std::size_t i = 0; i < sizeof...(Fields); i++) {
+        if(keys[i] == Key) {
+            return sizes[i];
+        }
+    }
+    return std::numeric_limits<std::size_t>::max();
+}
+
+template <std::size_t Offset, typename... Fields>
+constexpr std::size_t get_field_offset(int Key) {
+    constexpr int keys[] = {Fields::key...};
+    constexpr std::size_t sizes[] = {StateVectorDimension<typename Fields::type>...};
+    std::size_t offset = Offset;
+    for(std::size_t i = 0; i < sizeof...(Fields); i++) {
+        if(keys[i] == Key) {
+            return offset;
+        }
+        offset += sizes[i];
+    }
+    return std::numeric_limits<std::size_t>::max();
+}
+
+template <std::size_t Offset, typename... Fields>
+constexpr std::size_t get_field_covariance_offset(int Key) {
+    constexpr int keys[] = {Fields::key...};
+    constexpr std::size_t sizes[] = {CovarianceDimension<typename Fields::type>...};
+    std::size_t offset = Offset;
+    for(std::size_t i = 0; i < sizeof...(Fields); i++) {
+        if(keys[i] == Key) {
+            return offset;
+        }
+        offset += sizes[i];
+    }
+    return std::numeric_limits<std::size_t>::max();
+}
+
+template <std::size_t Index, typename... Fields>
+constexpr std::size_t get_field_order(int Key) {
+    constexpr int keys[] = {Fields::key...};
+    for(std::size_t i = 0; i < sizeof...(Fields); i++) {
+        if(keys[i] == Key) {
+            return Index + i;
+        }
+    }
+    return std::numeric_limits<std::size_t>::max();
+}
+
+/* Type of the field with a given key, or void if it is not present. */
+template <int Key, typename... Fields>
+struct FieldTypes {
+    using type = void;
+};
+
+template <int Key, typename T, typename... Tail>
+struct FieldTypes<Key, T, Tail...> {
+    using type = typename std::conditional<T::key == Key,
+        typename T::type, typename FieldTypes<Key, Tail...>::type>::type;
+};
+
+/* Create an array with every element set to the same value. */
+template <std::size_t N, typename T>
+inline std::array<T, N> create_array(const T& value) {
+    std::array<T, N> temp;
+    temp.fill(value);
+    return temp;
+}
+
+/*
+Convert between a field and its storage in a vector segment. Quaternions are
+stored as (x, y, z, w).
+*/
+template <typename T, typename S>
+inline T convert_from_segment(const S& segment) {
+    if constexpr(std::is_same<T, real_t>::value) {
+        return segment(0);
+    } else if constexpr(std::is_same<T, Quaternion>::value) {
+        return Quaternion(segment(3), segment(0), segment(1), segment(2));
+    } else {
+        return T(segment);
+    }
+}
+
+template <typename T>
+inline Vector<StateVectorDimension<T>> convert_to_segment(const T& field) {
+    Vector<StateVectorDimension<T>> temp;
+    if constexpr(std::is_same<T, Quaternion>::value) {
+        temp << field.vec(), field.w();
+    } else {
+        temp << field;
+    }
+    return temp;
+}
+
+/*
+Convert an MRP rotation vector into a unit quaternion. See equation 45 from
+the Crassidis and Markley paper.
+*/
+template <typename T>
+inline Quaternion rotation_vector_to_quaternion(const Vector<3>& r) {
+    real_t x_2 = r.squaredNorm();
+    real_t f_2 = Parameters::MRP_F<T> * Parameters::MRP_F<T>;
+    real_t a = Parameters::MRP_A<T>;
+    real_t d_q_w = (-a * x_2 + Parameters::MRP_F<T> * std::sqrt(f_2 + (real_t(1.0) - a * a) * x_2)) / (f_2 + x_2);
+    Vector<3> d_q_xyz = r * (a + d_q_w) / Parameters::MRP_F<T>;
+
+    return Quaternion(d_q_w, d_q_xyz(0), d_q_xyz(1), d_q_xyz(2));
+}
+
+/* Convert a unit quaternion into an MRP rotation vector. */
+template <typename T>
+inline Vector<3> quaternion_to_rotation_vector(const Quaternion& q) {
+    /* Use the shortest rotation. */
+    Quaternion temp = q.w() < real_t(0.0) ? Quaternion(-q.w(), -q.x(), -q.y(), -q.z()) : q;
+
+    return Parameters::MRP_F<T> * temp.vec() / (Parameters::MRP_A<T> + temp.w());
+}
+
+}
+
+/*
+A state vector made of a set of fields. All storage is sized at compile
+time, including the sigma point distribution, so a filter iteration does not
+allocate.
+
+The process model is supplied either by specialising derivative() and using
+one of the integrators, or by passing a custom integrator type to the filter
+core which implements integrate() directly.
+*/
+template <typename... Fields>
+class StateVector : public Vector<Detail::get_composite_vector_dimension<typename Fields::type...>()> {
+public:
+    /* Inherit Eigen::Matrix constructors and assignment operators. */
+    using Base = Vector<Detail::get_composite_vector_dimension<typename Fields::type...>()>;
+    using Base::Base;
+    using Base::operator=;
+
+    /* Get size of state vector. */
+    static constexpr std::size_t size() {
+        return Detail::get_composite_vector_dimension<typename Fields::type...>();
+    }
+
+    /* Get size of state vector delta and covariance. */
+    static constexpr std::size_t covariance_size() {
+        return Detail::get_covariance_dimension<typename Fields::type...>();
+    }
+
+    /* Get number of sigma points. */
+    static constexpr std::size_t num_sigma() {
+        return 2 * covariance_size() + 1;
+    }
+
+    /* Aliases for types needed during filter iteration. */
+    using StateVectorDelta = Vector<covariance_size()>;
+    using CovarianceMatrix = Matrix<covariance_size(), covariance_size()>;
+    using SigmaPointDistribution = Matrix<size(), num_sigma()>;
+    using SigmaPointDeltas = Matrix<covariance_size(), num_sigma()>;
+
+    /* Functions for accessing individual fields. */
+    template <int Key>
+    typename Detail::FieldTypes<Key, Fields...>::type get_field() const {
+        static_assert(Detail::get_field_offset<0, Fields...>(Key) != std::numeric_limits<std::size_t>::max(),
+            "Specified key not present in state vector");
+        return Detail::convert_from_segment<typename Detail::FieldTypes<Key, Fields...>::type>(
+            Base::template segment<Detail::get_field_size<Fields...>(Key)>(
+                Detail::get_field_offset<0, Fields...>(Key)));
+    }
+
+    template <int Key, typename T>
+    void set_field(T in) {
+        static_assert(Detail::get_field_offset<0, Fields...>(Key) != std::numeric_limits<std::size_t>::max(),
+            "Specified key not present in state vector");
+        Base::template segment<Detail::get_field_size<Fields...>(Key)>(
+            Detail::get_field_offset<0, Fields...>(Key)) =
+            Detail::convert_to_segment<typename Detail::FieldTypes<Key, Fields...>::type>(in);
+    }
+
+    /*
+    Calculate the sigma point distribution from the state and the scaled
+    root covariance. See equations 17 and 18 from the Kraft paper.
+    */
+    SigmaPointDistribution calculate_sigma_point_distribution(const CovarianceMatrix& S) const {
+        SigmaPointDistribution X;
+        X.col(0) = *this;
+
+        for(std::size_t i = 0; i < covariance_size(); i++) {
+            StateVector plus = *this;
+            plus.apply_delta(S.col(i));
+            X.col(i+1) = plus;
+
+            StateVector minus = *this;
+            minus.apply_delta(-S.col(i));
+            X.col(i+1+covariance_size()) = minus;
+        }
+
+        return X;
+    }
+
+    /* Calculate the weighted mean of a sigma point distribution. */
+    static StateVector calculate_sigma_point_mean(const SigmaPointDistribution& X) {
+        StateVector mean;
+        (mean.template calculate_field_mean<Fields>(X), ...);
+        return mean;
+    }
+
+    /* Calculate the difference between each sigma point and the mean. */
+    SigmaPointDeltas calculate_sigma_point_deltas(const SigmaPointDistribution& X) const {
+        SigmaPointDeltas w_prime;
+        (calculate_field_deltas<Fields>(X, w_prime), ...);
+        return w_prime;
+    }
+
+    /* Calculate the covariance of a set of sigma point deltas. */
+    static CovarianceMatrix calculate_sigma_point_covariance(const SigmaPointDeltas& W) {
+        CovarianceMatrix cov = Parameters::Sigma_WC0<StateVector> * (W.col(0) * W.col(0).transpose());
+        cov.noalias() += Parameters::Sigma_WCI<StateVector> *
+            (W.template rightCols<num_sigma()-1>() * W.template rightCols<num_sigma()-1>().transpose());
+        return cov;
+    }
+
+    /*
+    Apply a delta vector to the state. Vector fields are added, while
+    quaternion fields are rotated by the delta's rotation vector.
+    */
+    void apply_delta(const StateVectorDelta& delta) {
+        (apply_field_delta<Fields>(delta), ...);
+    }
+
+    /*
+    Time derivative of the state, to be specialised by the user when using
+    one of the integrators.
+    */
+    template <typename... U>
+    StateVector derivative(const U&... input) const;
+
+    /* Propagate the state forward in time using the process model. */
+    template <typename IntegratorType, typename... U>
+    StateVector process_model(real_t delta, const U&... input) const {
+        return IntegratorType::integrate(delta, *this, input...);
+    }
+
+private:
+    template <typename T>
+    void calculate_field_mean(const SigmaPointDistribution& X) {
+        using Type = typename T::type;
+        constexpr std::size_t offset = Detail::get_field_offset<0, Fields...>(T::key);
+        constexpr std::size_t length = Detail::StateVectorDimension<Type>;
+
+        if constexpr(std::is_same<Type, Quaternion>::value) {
+            /*
+            Average the rotations from the central sigma point to each other
+            sigma point, then apply the mean rotation to the central point.
+            */
+            Quaternion centre = Detail::convert_from_segment<Quaternion>(X.template block<4, 1>(offset, 0));
+            Vector<3> temp = Vector<3>::Zero();
+
+            for(std::size_t i = 1; i < num_sigma(); i++) {
+                Quaternion point = Detail::convert_from_segment<Quaternion>(X.template block<4, 1>(offset, i));
+                temp += Parameters::Sigma_WMI<StateVector> *
+                    Detail::quaternion_to_rotation_vector<StateVector>(point * centre.conjugate());
+            }
+
+            Quaternion mean = Detail::rotation_vector_to_quaternion<StateVector>(temp) * centre;
+            Base::template segment<4>(offset) = Detail::convert_to_segment<Quaternion>(mean.normalized());
+        } else {
+            Base::template segment<length>(offset) =
+                Parameters::Sigma_WM0<StateVector> * X.template block<length, 1>(offset, 0) +
+                Parameters::Sigma_WMI<StateVector> *
+                X.template block<length, num_sigma()-1>(offset, 1).rowwise().sum();
+        }
+    }
+
+    template <typename T>
+    void calculate_field_deltas(const SigmaPointDistribution& X, SigmaPointDeltas& w_prime) const {
+        using Type = typename T::type;
+        constexpr std::size_t offset = Detail::get_field_offset<0, Fields...>(T::key);
+        constexpr std::size_t cov_offset = Detail::get_field_covariance_offset<0, Fields...>(T::key);
+        constexpr std::size_t length = Detail::StateVectorDimension<Type>;
+
+        if constexpr(std::is_same<Type, Quaternion>::value) {
+            Quaternion mean = Detail::convert_from_segment<Quaternion>(Base::template segment<4>(offset));
+
+            for(std::size_t i = 0; i < num_sigma(); i++) {
+                Quaternion point = Detail::convert_from_segment<Quaternion>(X.template block<4, 1>(offset, i));
+                w_prime.template block<3, 1>(cov_offset, i) =
+                    Detail::quaternion_to_rotation_vector<StateVector>(point * mean.conjugate());
+            }
+        } else {
+            w_prime.template block<length, num_sigma()>(cov_offset, 0) =
+                X.template block<length, num_sigma()>(offset, 0).colwise() -
+                Base::template segment<length>(offset);
+        }
+    }
+
+    template <typename T>
+    void apply_field_delta(const StateVectorDelta& delta) {
+        using Type = typename T::type;
+        constexpr std::size_t offset = Detail::get_field_offset<0, Fields...>(T::key);
+        constexpr std::size_t cov_offset = Detail::get_field_covariance_offset<0, Fields...>(T::key);
+        constexpr std::size_t length = Detail::StateVectorDimension<Type>;
+
+        if constexpr(std::is_same<Type, Quaternion>::value) {
+            Quaternion q = Detail::convert_from_segment<Quaternion>(Base::template segment<4>(offset));
+            Quaternion rotation = Detail::rotation_vector_to_quaternion<StateVector>(
+                delta.template segment<3>(cov_offset));
+            Base::template segment<4>(offset) = Detail::convert_to_segment<Quaternion>((rotation * q).normalized());
+        } else {
+            Base::template segment<length>(offset) += delta.template segment<length>(cov_offset);
+        }
+    }
+};
+
+}
+
+#endif
\ No newline at end of file